@@ -1,2 +0,0 @@
-#include "globals.hpp"
-bool g_rsusCanDist = false; 
@@ -1 +0,0 @@
-extern bool g_rsusCanDist;
@@ -52,7 +52,14 @@ ConsumerZipfMandelbrot::GetTypeId(void)
       .AddAttribute("s", "parameter of power", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetS,
                                        &ConsumerZipfMandelbrot::GetS),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("PopularityFile",
+                    "Popularity table precomputed with PopularityTable::Save. If set, "
+                    "NumberOfContents, q and s are taken from the file",
+                    StringValue(""),
+                    MakeStringAccessor(&ConsumerZipfMandelbrot::m_popularityFile),
+                    MakeStringChecker());
 
   return tid;
 }
@@ -71,23 +78,24 @@ ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot()
 }
 
 void
-ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
+ConsumerZipfMandelbrot::AttachPopularityTable()
 {
-  m_N = numOfContents;
-
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+  if (m_popularityFile.empty()) {
+    m_popularity = PopularityTable::Get(m_N, m_q, m_s);
+    return;
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_popularity = PopularityTable::Load(m_popularityFile);
+  m_N = m_popularity->GetN();
+  m_q = m_popularity->GetQ();
+  m_s = m_popularity->GetS();
+}
+
+void
+ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
+{
+  m_N = numOfContents;
+  m_popularity = nullptr; // attached again when needed
 }
 
 uint32_t
@@ -100,7 +108,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_popularity = nullptr;
 }
 
 double
@@ -113,7 +121,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_popularity = nullptr;
 }
 
 double
@@ -165,29 +173,12 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  shared_ptr<Interest> interest =
+    m_interestTemplate.Make(seq, m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -198,8 +189,9 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_popularity == nullptr) {
+    AttachPopularityTable();
+  }
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
@@ -207,19 +199,28 @@ ConsumerZipfMandelbrot::GetNextSeq()
   }
   // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_popularity->Sample(p_random); //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
 
+void
+ConsumerZipfMandelbrot::StartApplication()
+{
+  // computed (or mapped) once here instead of on every attribute change, unless already shared
+  AttachPopularityTable();
+
+  ConsumerCbr::StartApplication();
+}
+
+void
+ConsumerZipfMandelbrot::PrepareInterestTemplate()
+{
+  // sequence number is appended to the name
+  m_interestTemplate = InterestTemplate(Interest(m_interestName), true);
+}
+
 void
 ConsumerZipfMandelbrot::ScheduleNextPacket()
 {
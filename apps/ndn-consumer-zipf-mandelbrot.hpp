@@ -27,6 +27,8 @@
 #include "ndn-consumer.hpp"
 #include "ndn-consumer-cbr.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-popularity-table.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -71,7 +73,19 @@ protected:
   virtual void
   ScheduleNextPacket();
 
+  virtual void
+  StartApplication();
+
+  virtual void
+  PrepareInterestTemplate();
+
 private:
+  /**
+   * \brief Attach to the shared popularity table for the current parameters
+   */
+  void
+  AttachPopularityTable();
+
   void
   SetNumberOfContents(uint32_t numOfContents);
 
@@ -94,7 +108,8 @@ private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  std::string m_popularityFile; // precomputed popularity table (optional)
+  shared_ptr<const PopularityTable> m_popularity; // cumulative probability, set at start
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -28,23 +28,24 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/object-factory.h"
 #include "ns3/mobility-module.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-content-trigger-engine.hpp"
 #include "helper/ndn-fib-helper.hpp"
 #include "NFD/daemon/face/face.hpp"
-#include "NFD/daemon/fw/forwarder.hpp"
-#include "NFD/daemon/table/cs.hpp"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/tracers/ndn-awareness-recorder.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 #include <iostream>
-#include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.Consumer");
 
@@ -73,6 +74,18 @@ Consumer::GetTypeId(void)
                     StringValue("50ms"),
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
+      .AddAttribute("RetxPolling",
+                    "If true, check retransmission timeouts every RetxTimer. Otherwise, "
+                    "schedule one event for the earliest retransmission deadline",
+                    BooleanValue(false), MakeBooleanAccessor(&Consumer::m_retxPolling),
+                    MakeBooleanChecker())
+      .AddAttribute("RttEstimator",
+                    "Type of the RTT estimator, e.g., ns3::ndn::RttSeqMeanDeviation to sample "
+                    "Data that arrive out of order",
+                    TypeIdValue(RttMeanDeviation::GetTypeId()),
+                    MakeTypeIdAccessor(&Consumer::SetRttEstimatorType,
+                                       &Consumer::GetRttEstimatorType),
+                    MakeTypeIdChecker())
       .AddAttribute("SimEnd",
                     "Node is aware of the simulation end time",
                     UintegerValue(0), MakeUintegerAccessor(&Consumer::m_simEnd),
@@ -91,6 +104,10 @@ Consumer::GetTypeId(void)
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("AwarenessLoggingDir", "Where awareness traces our outputted", StringValue("./"),
                     MakeStringAccessor(&Consumer::m_awarenessOutputDir), MakeStringChecker())
+      .AddAttribute("WatchedPrefixes",
+                    "Space-separated prefixes of critical content, awareness of which is tracked",
+                    StringValue("/criticalData/test"),
+                    MakeStringAccessor(&Consumer::m_watchedPrefixes), MakeStringChecker())
       .AddTraceSource("LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_lastRetransmittedInterestDataDelay),
@@ -105,8 +122,10 @@ Consumer::GetTypeId(void)
 
 Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
+  , m_contentTriggerZoneId(0)
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_retxPolling(false)
 {
   NS_LOG_FUNCTION_NOARGS();
 
@@ -117,13 +136,13 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
-  if (m_retxEvent.IsRunning()) {
+  if (m_retxPolling && m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
-  }
 
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+    // schedule even with new timeout
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  }
 }
 
 Time
@@ -132,6 +151,20 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+Consumer::SetRttEstimatorType(TypeId type)
+{
+  ObjectFactory factory;
+  factory.SetTypeId(type);
+  m_rtt = factory.Create<RttEstimator>();
+}
+
+TypeId
+Consumer::GetRttEstimatorType() const
+{
+  return m_rtt->GetInstanceTypeId();
+}
+
 void
 Consumer::CheckRetxTimeout()
 {
@@ -140,20 +173,34 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+  m_seqWindow.ExpireTimeouts(rto, now, [this] (uint32_t seqNo) { OnTimeout(seqNo); });
+
+  if (m_retxPolling) {
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
   }
+  else {
+    ScheduleRetxCheck();
+  }
+}
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+void
+Consumer::ScheduleRetxCheck()
+{
+  if (m_retxPolling)
+    return;
+
+  Time start;
+  if (!m_seqWindow.GetEarliestTimeout(start))
+    return; // nothing is outstanding, an already armed event will find nothing to do
+
+  Time now = Simulator::Now();
+  Time deadline = std::max(start + m_rtt->RetransmitTimeout(), now);
+  if (m_retxEvent.IsRunning() && m_retxDeadline <= deadline)
+    return;
+
+  Simulator::Cancel(m_retxEvent);
+  m_retxDeadline = deadline;
+  m_retxEvent = Simulator::Schedule(deadline - now, &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
@@ -165,74 +212,96 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  m_l3 = GetNode()->GetObject<L3Protocol>();
+
+  if (m_retxPolling) {
+    Simulator::Cancel(m_retxEvent);
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  }
+
+  PrepareInterestTemplate();
   ScheduleNextPacket();
 
-  UtilityScheduler();
-}
+  // awareness is tracked only when the node knows the simulation end, as before
+  m_awareness.clear();
+  if (m_simEnd <= 1)
+    return;
 
-void Consumer::UtilityScheduler() {
-  for (uint32_t i = 1; i < m_simEnd; i++) {
-    Simulator::Schedule(Seconds(i), &Consumer::UtilityLoop, this);
-    if (i == (m_simEnd - 1)) {
-        Simulator::Schedule(Seconds(i), &Consumer::PrintAwarenessStats, this);
-    }
+  // one subscription per watched prefix; arrival cost does not depend on CS size
+  std::istringstream prefixes(m_watchedPrefixes);
+  std::string prefix;
+  while (prefixes >> prefix) {
+    Awareness awareness;
+    awareness.prefix = Name(prefix);
+    awareness.watchId = m_l3->watchPrefix(awareness.prefix,
+                                          std::bind(&Consumer::OnContentArrival, this,
+                                                    m_awareness.size(), std::placeholders::_1));
+    m_awareness.push_back(awareness);
   }
+
+  // the engine moves the content from now on; the zone is shared with the other apps that use
+  // the same CTx and start at the same time
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  m_contentTriggerZoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(m_contentTrigger_x_start,
+                                                       m_contentTrigger_x_end,
+                                                       m_contentTrigger_x_speed, Seconds(0),
+                                                       Time::Max(), Simulator::Now()));
+
+  m_awarenessEvent =
+    Simulator::Schedule(Seconds(m_simEnd - 1), &Consumer::PrintAwarenessStats, this);
 }
 
-void Consumer::UtilityLoop() {
-  double current_x = GetNode()->GetObject<MobilityModel>()->GetPosition().x;
-  if (!m_aware) {
-      // Check CS for data prefix matching /criticalData
-      bool matching = false;
-      nfd::cs::Cs& contentStore = GetNode()->GetObject<L3Protocol>()->getForwarder()->getCs();
-
-      nfd::cs::Cs::const_iterator iter;
-      for (iter = contentStore.begin(); iter != contentStore.end(); iter++) {
-          if (iter->getName().equals("/criticalData/test")) {
-              matching = true;
-          }
-      }
+void
+Consumer::OnContentArrival(size_t index, const Data& data)
+{
+  Awareness& awareness = m_awareness[index];
+  if (awareness.aware)
+    return;
 
-      if (matching) {
-          m_aware = true;
-          //Get location of node, mark distance from content
-          double content_x = (m_contentTrigger_x_start + m_contentTrigger_x_end) / 2;
-          m_awarenessDistance = content_x - current_x; //if positive, before content. Otherwise after.
-          double current_x_speed = 100.0;//GetNode()->GetObject<MobilityModel>()->GetVelocity().x;//(current_x - m_last_x); // No division here as this measurement is taken once every second.
-          IsNodeSafelyAware(current_x_speed) ? (m_safelyInformed = true) : (m_safelyInformed = false);
-          m_awarenessTime = Simulator::Now().GetSeconds();
-      }
+  awareness.aware = true;
+  // recorded at insertion time, not at the next 1s poll
+  awareness.awarenessTime = Simulator::Now().GetSeconds();
+
+  Ptr<MobilityModel> mobility = GetNode()->GetObject<MobilityModel>();
+  if (mobility == nullptr) {
+    NS_LOG_DEBUG("Node " << GetNode()->GetId() << " has no mobility, distance is not known");
+    return;
   }
-  m_contentTrigger_x_start = m_contentTrigger_x_start + m_contentTrigger_x_speed;
-  m_contentTrigger_x_end = m_contentTrigger_x_end + m_contentTrigger_x_speed;
+
+  //Get location of node, mark distance from content
+  double current_x = mobility->GetPosition().x;
+  double content_x = ContentTriggerEngine::Get()->GetZoneCenter(m_contentTriggerZoneId).x;
+  awareness.awarenessDistance = content_x - current_x; //if positive, before content. Otherwise after.
+  double current_x_speed = 100.0;//GetNode()->GetObject<MobilityModel>()->GetVelocity().x;
+  awareness.safelyInformed = IsNodeSafelyAware(current_x_speed, awareness.awarenessDistance);
 }
 
 bool
-Consumer::IsNodeSafelyAware(double nodeSpeed) {
+Consumer::IsNodeSafelyAware(double nodeSpeed, int32_t awarenessDistance) {
   double perceptionDistance = (0.278 * 1.5) * nodeSpeed;
   double speedSquared = nodeSpeed * nodeSpeed;
   double brakingDistance = speedSquared / (254 * 0.7);
   double totalDistanceToBrake = perceptionDistance + brakingDistance;
-  return (totalDistanceToBrake <= m_awarenessDistance);
+  return (totalDistanceToBrake <= awarenessDistance);
 }
 
 void
 Consumer::PrintAwarenessStats() {
-  std::cout << "Node " << GetNode()->GetId() << ": m_awarenessDistance: " << m_awarenessDistance << '\n';
-  std::string traceOutput = std::getenv("NS3_TRACE_OUTPUTS");
-  std::string awarenessTraceOutput = m_awarenessOutputDir + "/awareness-trace.txt";
-  std::ofstream awarenessTraceOutputFile;
-  awarenessTraceOutputFile.open(awarenessTraceOutput.c_str(), std::ios_base::app);
-  if (m_awarenessDistance < -100) {
-      m_aware = false;
+  // records are written in one pass by the shared recorder when the simulator is destroyed
+  Ptr<AwarenessRecorder> recorder = AwarenessRecorder::Get(m_awarenessOutputDir);
+  for (Awareness& awareness : m_awareness) {
+    NS_LOG_DEBUG("Node " << GetNode()->GetId() << ": " << awareness.prefix
+                 << " m_awarenessDistance: " << awareness.awarenessDistance);
+    if (awareness.awarenessDistance < -100) {
+        awareness.aware = false;
+    }
+    recorder->Record(awareness.prefix, GetNode()->GetId(), awareness.aware,
+                     awareness.safelyInformed, awareness.awarenessTime,
+                     awareness.awarenessDistance);
   }
-  awarenessTraceOutputFile << GetNode()->GetId() << "  " << m_awarenessDistance
-                           << "  " << m_aware << "  " << m_awarenessTime
-                           << "  " << m_safelyInformed << std::endl;
-  awarenessTraceOutputFile.close();
 }
 
-
 void
 Consumer::StopApplication() // Called at time specified by Stop
 {
@@ -240,12 +309,39 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
+
+  if (m_awarenessEvent.IsRunning()) {
+    Simulator::Cancel(m_awarenessEvent);
+    // stopped before SimEnd - 1, awareness does not change afterwards
+    PrintAwarenessStats();
+  }
+
+  Ptr<L3Protocol> l3 = GetNode()->GetObject<L3Protocol>();
+  for (const Awareness& awareness : m_awareness) {
+    l3->unwatchPrefix(awareness.watchId);
+  }
+
+  // Interests still outstanding are abandoned, drop their send history
+  m_rtt->ClearSent();
 
   // cleanup base stuff
   App::StopApplication();
 
 }
 
+void
+Consumer::PrepareInterestTemplate()
+{
+  Interest interest(m_interestName);
+  interest.setCanBePrefix(true);
+  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+  interest.setInterestLifetime(interestLifeTime);
+  interest.setMustBeFresh(true);
+
+  m_interestTemplate = InterestTemplate(interest);
+}
+
 void
 Consumer::SendPacket()
 {
@@ -272,19 +368,8 @@ Consumer::SendPacket()
     seq = m_seq++;
   }
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  // shared_ptr<Interest> interest = make_shared<Interest> ();
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(m_interestName);
-  interest->setCanBePrefix(true);
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
-  interest->setMustBeFresh(true);
+  shared_ptr<Interest> interest =
+    m_interestTemplate.Make(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
 
   NS_LOG_INFO("> Interest for " << seq);
 
@@ -330,24 +415,18 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  SeqWindow::Entry* entry = m_seqWindow.Find(seq);
+  if (entry != nullptr && m_l3->isTraced(data->getName())) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSent, entry->retxCount,
+                             hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
+  m_seqWindow.Erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
+  ScheduleRetxCheck();
 }
 
 void
@@ -368,8 +447,7 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   // m_rtt->RetransmitTimeout ().ToDouble (Time::S) << "s\n";
 
   m_rtt->IncreaseMultiplier(); // Double the next RTO
-  m_rtt->SentSeq(SequenceNumber32(sequenceNumber),
-                 1); // make sure to disable RTT calculation for this sample
+  m_rtt->TimeoutSeq(SequenceNumber32(sequenceNumber)); // disable RTT calculation for this sample
   m_retxSeqs.insert(sequenceNumber);
   ScheduleNextPacket();
 }
@@ -378,17 +456,12 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqWindow.GetArmedCount() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_seqWindow.Sent(sequenceNumber, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+  ScheduleRetxCheck();
 }
 
 
@@ -29,15 +29,14 @@
 #include "ns3/data-rate.h"
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-seq-window.hpp"
+#include "ns3/ndnSIM/utils/ndn-interest-template.hpp"
 
 #include <set>
 #include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -97,17 +96,18 @@ public:
   typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
 
 private:
-  virtual void
-  UtilityScheduler();
-
-  virtual void
-  UtilityLoop();
+  /**
+   * @brief Called when content under the watched prefix is cached on the node
+   * @param index index of the watched prefix in m_awareness
+   */
+  void
+  OnContentArrival(size_t index, const Data& data);
 
   virtual void
   PrintAwarenessStats();
 
   virtual bool
-  IsNodeSafelyAware(double nodeSpeed);
+  IsNodeSafelyAware(double nodeSpeed, int32_t awarenessDistance);
 
 protected:
 
@@ -125,12 +125,27 @@ protected:
   virtual void
   ScheduleNextPacket() = 0;
 
+  /**
+   * \brief Pre-encodes m_interestTemplate from the attributes, called from StartApplication
+   */
+  virtual void
+  PrepareInterestTemplate();
+
   /**
    * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
    */
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Arms the retransmission event for the earliest outstanding deadline (unless polling)
+   *
+   * Only a deadline earlier than the armed one re-arms the event.  A later deadline is picked up
+   * when the armed event fires.
+   */
+  void
+  ScheduleRetxCheck();
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -145,31 +160,61 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Replaces the RTT estimator with a new one of the given type
+   * \param type TypeId of an RttEstimator subclass
+   */
+  void
+  SetRttEstimatorType(TypeId type);
+
+  /**
+   * \brief Returns the type of the RTT estimator
+   */
+  TypeId
+  GetRttEstimatorType() const;
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
+  Ptr<L3Protocol> m_l3; ///< @brief NDN stack of the node (set by StartApplication)
   std::string m_awarenessOutputDir;
+  std::string m_watchedPrefixes; ///< @brief space-separated prefixes of critical content
 
-  bool m_aware = false;
-  bool m_safelyInformed = false;
-  double m_last_x;
-  double m_awarenessTime;
-  int32_t m_awarenessDistance = 0;
+  /// @cond include_hidden
+  /**
+   * \struct Awareness of the node about one watched critical content prefix
+   */
+  struct Awareness {
+    Name prefix;
+    bool aware = false;
+    bool safelyInformed = false;
+    double awarenessTime = 0;
+    int32_t awarenessDistance = 0;
+    uint64_t watchId = 0;
+  };
+  /// @endcond
+
+  std::vector<Awareness> m_awareness; ///< @brief awareness per watched prefix
   uint32_t m_simEnd;
+  EventId m_awarenessEvent; ///< @brief records awareness stats SimEnd - 1 seconds after start
   uint32_t m_contentTrigger_x_start;
   uint32_t m_contentTrigger_x_end;
   uint32_t m_contentTrigger_x_speed;
+  uint32_t m_contentTriggerZoneId; ///< @brief zone in ContentTriggerEngine, tracks the content
 
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
   EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  bool m_retxPolling;  ///< @brief check retransmissions every m_retxTimer instead of at deadlines
+  Time m_retxDeadline; ///< @brief Time m_retxEvent is scheduled for (unless polling)
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  InterestTemplate m_interestTemplate; ///< \brief pre-encoded Interest, nonce patched per send
 
   /// @cond include_hidden
   /**
@@ -180,54 +225,7 @@ protected:
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  SeqWindow m_seqWindow; ///< \brief send times, retx counts and timers of outstanding Interests
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
@@ -30,9 +30,8 @@
 
 
 #include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-content-trigger-engine.hpp"
 #include "helper/ndn-fib-helper.hpp"
-#include "NFD/daemon/fw/forwarder.hpp"
-#include "NFD/daemon/table/cs.hpp"
 
 #include <memory>
 
@@ -72,9 +71,13 @@ ProactiveProducer::GetTypeId(void)
                     "Name to be used for key locator.  If root, then key locator is not used",
                     NameValue(), MakeNameAccessor(&ProactiveProducer::m_keyLocator), MakeNameChecker())
       .AddAttribute("SimEnd",
-                    "Node is aware of the simulation end time",
+                    "Node is aware of the simulation end time, content is distributed only "
+                    "if SimEnd is above 1",
                     UintegerValue(0), MakeUintegerAccessor(&ProactiveProducer::m_simEnd),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("WatchedPrefix", "Prefix of critical content, caching of which is tracked",
+                    StringValue("/criticalData/test"),
+                    MakeNameAccessor(&ProactiveProducer::m_watchedPrefix), MakeNameChecker())
       .AddAttribute("CTxStart",
                     "Where PCD is triggered",
                     UintegerValue(0), MakeUintegerAccessor(&ProactiveProducer::m_contentTrigger_x_start),
@@ -111,7 +114,31 @@ ProactiveProducer::StartApplication()
 
   App::StartApplication();
 
-  ProactiveProducer::UtilityScheduler();
+  PrepareDataTemplate();
+
+  // content is distributed only when the node knows the simulation end, as before
+  if (m_simEnd <= 1)
+    return;
+
+  m_contentWatchId =
+    GetNode()->GetObject<L3Protocol>()->watchPrefix(m_watchedPrefix,
+                                                    std::bind(&ProactiveProducer::OnContentArrival,
+                                                              this, std::placeholders::_1));
+
+  if (m_contentTrigger_l_end > m_contentTrigger_l_start) {
+    Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+    double error = 2.0;
+    uint32_t zoneId =
+      engine->AddZone(ContentTriggerEngine::MakeRoadZone(m_contentTrigger_x_start - error,
+                                                         m_contentTrigger_x_end + error,
+                                                         m_contentTrigger_x_speed,
+                                                         Seconds(m_contentTrigger_l_start),
+                                                         Seconds(m_contentTrigger_l_end),
+                                                         Simulator::Now()));
+    m_contentTriggerWatchId =
+      engine->Watch(zoneId, GetNode(),
+                    std::bind(&ProactiveProducer::OnContentTrigger, this, std::placeholders::_1));
+  }
 }
 
 void
@@ -119,45 +146,53 @@ ProactiveProducer::StopApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
 
-  App::StopApplication();
-}
+  GetNode()->GetObject<L3Protocol>()->unwatchPrefix(m_contentWatchId);
 
-void ProactiveProducer::UtilityScheduler() {
-  for (uint32_t i = 1; i < m_simEnd; i++) {
-    Simulator::Schedule(Seconds(i), &ProactiveProducer::UtilityLoop, this);
+  if (m_contentTriggerWatchId != 0) {
+    ContentTriggerEngine::Get()->Unwatch(m_contentTriggerWatchId);
+    m_contentTriggerWatchId = 0;
   }
+
+  App::StopApplication();
 }
 
-void ProactiveProducer::UtilityLoop() {
-  bool matching = false;
-  nfd::cs::Cs& contentStore = GetNode()->GetObject<L3Protocol>()->getForwarder()->getCs();
+void
+ProactiveProducer::PrepareDataTemplate()
+{
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+
+  data.setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
 
-  nfd::cs::Cs::const_iterator iter;
-  for (iter = contentStore.begin(); iter != contentStore.end(); iter++) {
-      if (iter->getName().equals("/criticalData/test")) {
-          matching = true;
-      }
-  }
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
-  // Keeps track of content trigger position, speed and lifetime
-  double current_x = GetNode()->GetObject<MobilityModel>()->GetPosition().x;
-  double error = 2.0;
-  bool isNodeInContentTrigger = (current_x >= (m_contentTrigger_x_start - error)) && (current_x < (m_contentTrigger_x_end + error));
-  // Check is node in contentTrigger area
-  if (isNodeInContentTrigger) {
-    //Check if contentTrigger is alive
-    double currentTime = Simulator::Now().GetSeconds();
-    if (m_contentTrigger_l_start <= currentTime && m_contentTrigger_l_end > currentTime) {
-      canDist = true;
-    }
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
   }
 
-  if (canDist && !matching && !hasDist) {
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+
+  data.setSignature(signature);
+
+  m_dataTemplate = DataTemplate(data);
+}
+
+void
+ProactiveProducer::OnContentArrival(const Data& data)
+{
+  m_contentCached = true;
+}
+
+void
+ProactiveProducer::OnContentTrigger(bool isInside)
+{
+  // distribute once, on entering the content trigger, unless the content already arrived
+  if (isInside && !m_contentCached && !hasDist) {
     ProactivelyDistributeData();
     hasDist = true;
   }
-  m_contentTrigger_x_start = m_contentTrigger_x_start + m_contentTrigger_x_speed;
-  m_contentTrigger_x_end = m_contentTrigger_x_end + m_contentTrigger_x_speed;
 }
 
 void
@@ -167,46 +202,18 @@ ProactiveProducer::ProactivelyDistributeData() {
   if (!m_active)
     return;
 
-  shared_ptr<Interest> interest = std::make_shared<ndn::Interest>(m_prefix);
-  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
-  interest->setNonce(rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setInterestLifetime(ndn::time::seconds(300));
-
-  auto data = make_shared<Data>();
-
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_prefix);
-  nameWithSequence->appendSequenceNumber(0);
-  data->setName(m_prefix);
-
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-  data->setSignature(signature);
-  // to create real wire encoding
-  data->wireEncode();
+  // only the name is encoded, MetaInfo, payload and signature come from the template
+  auto data = m_dataTemplate.Make(m_prefix);
 
   App::ProactivelyDistributeData(data); // tracing inside
   NS_LOG_FUNCTION(this << data);
 
-  nfd::cs::Cs& contentStore = GetNode()->GetObject<L3Protocol>()->getForwarder()->getCs();//.insert(*data, false);
-  contentStore.insert(*data, false);
-  // Making sure proactive data to distribute is in CS to avoid unexpected behaviour
-  // Turns out, 258 is a local face! 257 is non local and therefore actually
-  // emits the data. Can detect wheter or not a face is local or non-local with
-  // the non-static getScope() function in the Face class
-  // TODO: Make a new out-bound, non-local face so we dont have to rely on face 257
-  // being a present
-  shared_ptr<Face> face = GetNode()->GetObject<L3Protocol>()->getFaceById(257);
-  // std::cout << face->getScope() << '\n';
-  // Kick-starts the distribution process. Should only be called if the data is definitely within
-  // this nodes content store
-  GetNode()->GetObject<L3Protocol>()->getForwarder()->startProcessInterest(*face, *interest);
+  // cached, so that the node answers Interests for the Data and is aware of it
+  Ptr<L3Protocol> l3 = GetNode()->GetObject<L3Protocol>();
+  l3->cacheData(*data);
+
+  size_t nFaces = l3->pushData(*data);
+  NS_LOG_DEBUG("Pushed " << data->getName() << " on " << nFaces << " faces");
 
   // NS_LOG_UNCOND("Emmiting PCD " << *data);
 }
@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -58,15 +59,25 @@ protected:
 
 private:
   virtual void
-  UtilityScheduler();
+  ProactivelyDistributeData();
 
-  virtual void
-  UtilityLoop();
+  /**
+   * @brief Called by ContentTriggerEngine when the node enters or leaves the content trigger
+   */
+  void
+  OnContentTrigger(bool isInside);
 
-  virtual void
-  ProactivelyDistributeData();
+  void
+  OnContentArrival(const Data& data);
+
+  /**
+   * @brief Encode MetaInfo, payload and signature shared by all distributed Data
+   */
+  void
+  PrepareDataTemplate();
 
   Name m_prefix;
+  Name m_watchedPrefix; ///< @brief prefix of critical content, caching of which is tracked
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
   uint32_t m_simEnd;
@@ -79,8 +90,11 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
-  bool canDist = false;
+  DataTemplate m_dataTemplate;
   bool hasDist = false;
+  bool m_contentCached = false; ///< @brief critical content has been cached on the node
+  uint64_t m_contentWatchId = 0;
+  uint64_t m_contentTriggerWatchId = 0;
 };
 
 } // namespace ndn
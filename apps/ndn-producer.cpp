@@ -29,11 +29,10 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
-#include "NFD/daemon/fw/forwarder.hpp"
-#include "NFD/daemon/table/cs.hpp"
+#include "model/ndn-rsu-coordinator.hpp"
+#include "model/ndn-content-trigger-engine.hpp"
 
 #include <memory>
-#include "globals.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.Producer");
 
@@ -71,9 +70,13 @@ Producer::GetTypeId(void)
                     "Name to be used for key locator.  If root, then key locator is not used",
                     NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
       .AddAttribute("SimEnd",
-                    "Node is aware of the simulation end time",
+                    "Node is aware of the simulation end time, content is discovered only "
+                    "if SimEnd is above 1",
                     UintegerValue(0), MakeUintegerAccessor(&Producer::m_simEnd),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("WatchedPrefix", "Prefix of critical content, caching of which is tracked",
+                    StringValue("/criticalData/test"),
+                    MakeNameAccessor(&Producer::m_watchedPrefix), MakeNameChecker())
       .AddAttribute("CTxStart",
                     "Where PCD is triggered",
                     UintegerValue(0), MakeUintegerAccessor(&Producer::m_contentTrigger_x_start),
@@ -95,7 +98,7 @@ Producer::GetTypeId(void)
                     UintegerValue(0), MakeUintegerAccessor(&Producer::m_contentTrigger_x_speed),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("IsRSU",
-                    "Id This Producer an RSU",
+                    "Is this Producer an RSU (RSUs share discoveries via RsuCoordinator)",
                     BooleanValue(0), MakeBooleanAccessor(&Producer::m_isRSU),
                     MakeBooleanChecker());
       return tid;
@@ -115,7 +118,43 @@ Producer::StartApplication()
 
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 
-  UtilityScheduler();
+  PrepareDataTemplate();
+
+  // content is discovered only when the node knows the simulation end, as before
+  if (m_simEnd <= 1)
+    return;
+
+  m_contentWatchId =
+    GetNode()->GetObject<L3Protocol>()->watchPrefix(m_watchedPrefix,
+                                                    std::bind(&Producer::OnContentArrival, this,
+                                                              std::placeholders::_1));
+
+  if (m_isRSU) {
+    m_rsuCoordinator = GetNode()->GetObject<RsuCoordinator>();
+    if (m_rsuCoordinator == nullptr) {
+      m_rsuCoordinator = CreateObject<RsuCoordinator>();
+      GetNode()->AggregateObject(m_rsuCoordinator);
+    }
+    m_rsuSubscriptionId =
+      m_rsuCoordinator->Subscribe(m_watchedPrefix,
+                                  std::bind(&Producer::OnRsuDiscovery, this, std::placeholders::_1));
+  }
+
+  // RSUs are notified of discoveries by the RsuCoordinator
+  if (!m_isRSU && m_contentTrigger_l_end > m_contentTrigger_l_start) {
+    Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+    double error = 2.0;
+    uint32_t zoneId =
+      engine->AddZone(ContentTriggerEngine::MakeRoadZone(m_contentTrigger_x_start - error,
+                                                         m_contentTrigger_x_end + error,
+                                                         m_contentTrigger_x_speed,
+                                                         Seconds(m_contentTrigger_l_start),
+                                                         Seconds(m_contentTrigger_l_end),
+                                                         Simulator::Now()));
+    m_contentTriggerWatchId =
+      engine->Watch(zoneId, GetNode(),
+                    std::bind(&Producer::OnContentTrigger, this, std::placeholders::_1));
+  }
 }
 
 void
@@ -123,58 +162,67 @@ Producer::StopApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
 
+  GetNode()->GetObject<L3Protocol>()->unwatchPrefix(m_contentWatchId);
+
+  if (m_contentTriggerWatchId != 0) {
+    ContentTriggerEngine::Get()->Unwatch(m_contentTriggerWatchId);
+    m_contentTriggerWatchId = 0;
+  }
+
+  if (m_rsuCoordinator != nullptr) {
+    m_rsuCoordinator->Unsubscribe(m_rsuSubscriptionId);
+  }
+
   App::StopApplication();
 }
 
 void
-Producer::UtilityScheduler() {
-  for (uint32_t i = 1; i < m_simEnd; i++) {
-    Simulator::Schedule(Seconds(i), &Producer::UtilityLoop, this);
-  }
-}
+Producer::PrepareDataTemplate()
+{
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+
+  data.setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
 
-void Producer::UtilityLoop() {
-  bool matching = false;
-  nfd::cs::Cs& contentStore = GetNode()->GetObject<L3Protocol>()->getForwarder()->getCs();
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
 
-  nfd::cs::Cs::const_iterator iter;
-  for (iter = contentStore.begin(); iter != contentStore.end(); iter++) {
-      if (iter->getName().equals("/criticalData/test")) {
-          matching = true;
-      }
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
   }
 
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+
+  data.setSignature(signature);
+
+  m_dataTemplate = DataTemplate(data);
+}
+
+void
+Producer::OnContentArrival(const Data& data)
+{
+  m_contentCached = true;
+  m_contentDiscovered = true;
+
   if (m_isRSU) {
-    if (g_rsusCanDist) {
-      m_contentDiscovered = true;
-      // std::cout << "RSU node_(" << GetNode()->GetId() << ") has sensed content on the RSU net" << '\n';
-    }
-    else if (matching) {
-      // std::cout << "g_rsusCanDist = " << g_rsusCanDist << '\n';
-      // std::cout << "RSU node_(" << GetNode()->GetId() << ") has sniffed content" << '\n';
-      m_contentDiscovered = true;
-      g_rsusCanDist = true;
-    }
-    else {
-      m_contentDiscovered = false;
-    }
+    // sniffed by this RSU, share with the RSUs of the region
+    m_rsuCoordinator->ReportDiscovery(data.getName());
   }
+}
 
-  if (!m_isRSU) {
-    matching ? (m_contentDiscovered = true) : (m_contentDiscovered = false);
-    double current_x = GetNode()->GetObject<MobilityModel>()->GetPosition().x;
-    double error = 2.0;
-    // Check node is within the Content Trigger
-    bool isNodeInContentTrigger = (current_x >= (m_contentTrigger_x_start - error)) && (current_x < (m_contentTrigger_x_end + error));
-    if (!m_contentDiscovered && isNodeInContentTrigger) {
-      //Check if contentTrigger is alive
-      double currentTime = Simulator::Now().GetSeconds();
-      bool isContentTriggerActive = (m_contentTrigger_l_start <= currentTime && m_contentTrigger_l_end > currentTime);
-      isContentTriggerActive ? (m_contentDiscovered = true) : (m_contentDiscovered = false);
-    }
-  }
-  m_contentTrigger_x_start = m_contentTrigger_x_start + m_contentTrigger_x_speed;
-  m_contentTrigger_x_end = m_contentTrigger_x_end + m_contentTrigger_x_speed;
+void
+Producer::OnRsuDiscovery(const Name& name)
+{
+  NS_LOG_DEBUG("RSU node(" << GetNode()->GetId() << ") learned about " << name);
+  m_contentDiscovered = true;
+}
+
+void
+Producer::OnContentTrigger(bool isInside)
+{
+  m_inContentTrigger = isInside;
+  m_contentDiscovered = m_contentCached || m_inContentTrigger;
 }
 
 void
@@ -189,38 +237,11 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
       if (!m_active)
         return;
 
-      Name dataName(interest->getName());
-      // dataName.append(m_postfix);
-      // dataName.appendVersion();
-
-      auto data = make_shared<Data>();
-      data->setName(dataName);
-      data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-      data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-      Signature signature;
-      SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-      if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
-      }
-
-      signature.setInfo(signatureInfo);
-      signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-      data->setSignature(signature);
+      // name of Data is the same as in Interest
+      shared_ptr<Data> data = m_dataTemplate.Make(interest->getName());
 
       NS_LOG_DEBUG("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-      // to create real wire encoding
-      data->wireEncode();
-
-      shared_ptr<Interest> interest = std::make_shared<ndn::Interest>(m_prefix);
-      Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
-      interest->setNonce(rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-      interest->setInterestLifetime(ndn::time::seconds(300));
-
       m_transmittedDatas(data, this, m_face);
       m_appLink->onReceiveData(*data);
   }
@@ -24,6 +24,9 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-rsu-coordinator.hpp"
+#include "ns3/ndnSIM/model/ndn-content-trigger-engine.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -60,13 +63,29 @@ protected:
   StopApplication(); // Called at time specified by Stop
 
 private:
-  virtual void
-  UtilityScheduler();
-
-  virtual void
-  UtilityLoop();
+  void
+  OnContentArrival(const Data& data);
+
+  /**
+   * @brief Called when an RSU of the region discovers content under the watched prefix
+   */
+  void
+  OnRsuDiscovery(const Name& name);
+
+  /**
+   * @brief Called by ContentTriggerEngine when the node enters or leaves the content trigger
+   */
+  void
+  OnContentTrigger(bool isInside);
+
+  /**
+   * @brief Encode MetaInfo, payload and signature shared by all responses
+   */
+  void
+  PrepareDataTemplate();
 
   Name m_prefix;
+  Name m_watchedPrefix; ///< @brief prefix of critical content, caching of which is tracked
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
   uint32_t m_simEnd;
@@ -79,8 +98,15 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+  DataTemplate m_dataTemplate;
   bool m_contentDiscovered = false;
+  bool m_contentCached = false; ///< @brief critical content has been cached on the node
+  bool m_inContentTrigger = false; ///< @brief node is inside the active content trigger
+  uint64_t m_contentTriggerWatchId = 0;
+  uint64_t m_contentWatchId = 0;
   bool m_isRSU = false;
+  Ptr<RsuCoordinator> m_rsuCoordinator;
+  uint64_t m_rsuSubscriptionId = 0;
   bool m_hasDistToRSUNet = false;
 };
 
@@ -24,6 +24,8 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/ndnSIM-module.h"
 
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
 namespace ns3 {
 
 /**
@@ -41,6 +43,10 @@ namespace ns3 {
  * more than 2 seconds (can be cached for a shorter time, if entry is evicted earlier)
  *
  *     NS_LOG=ndn.Consumer ./waf --run ndn-simple-with-different-sizes-content-store
+ *
+ * Memory used by the simulation is printed at the end, e.g., to compare different payload sizes:
+ *
+ *     ./waf --run "ndn-simple-with-different-sizes-content-store --payloadSize=8192"
  */
 
 int
@@ -52,7 +58,9 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
 
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  std::string payloadSize = "1024";
   CommandLine cmd;
+  cmd.AddValue("payloadSize", "Virtual payload size of the producer", payloadSize);
   cmd.Parse(argc, argv);
 
   // Creating nodes
@@ -91,12 +99,13 @@ main(int argc, char* argv[])
   ndn::AppHelper producerHelper("ns3::ndn::Producer");
   // Producer will reply to all requests starting with /prefix
   producerHelper.SetPrefix("/prefix");
-  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.SetAttribute("PayloadSize", StringValue(payloadSize));
   producerHelper.Install(nodes.Get(2)); // last node
 
   Simulator::Stop(Seconds(20.0));
 
   Simulator::Run();
+  std::cout << "Memory usage: " << MemUsage::Get() / 1024.0 / 1024.0 << "MiB" << std::endl;
   Simulator::Destroy();
 
   return 0;
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-convert.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Converts traces written in the binary columnar format (tracers installed with a file name
+ * ending with .bin) into tab-separated text, as written by the tracers by default:
+ *
+ *     ./waf --run "ndn-trace-convert --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If --output is - (default), the text is written to the standard output.
+ */
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Output file (- for the standard output)", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "File " << input << " cannot be opened for reading" << std::endl;
+    return 1;
+  }
+
+  try {
+    ndn::BinaryTraceReader reader(is);
+
+    std::shared_ptr<ndn::TraceSink> sink = ndn::TraceSink::Open(output, reader.GetSchema());
+    if (sink == nullptr) {
+      std::cerr << "File " << output << " cannot be opened for writing" << std::endl;
+      return 1;
+    }
+
+    uint64_t nRecords = reader.ReadAll(*sink);
+    sink->Flush();
+    std::cerr << "Converted " << nRecords << " records" << std::endl;
+  }
+  catch (const ndn::BinaryTraceReader::Error& e) {
+    std::cerr << "ERROR: " << input << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
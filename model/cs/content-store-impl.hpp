@@ -125,6 +125,12 @@ public:
 
   virtual Ptr<Entry> Next(Ptr<Entry>);
 
+  virtual void
+  ForEachUnderPrefix(const Name& prefix, const std::function<void(Ptr<const Entry>)>& func);
+
+  virtual uint32_t
+  CountUnderPrefix(const Name& prefix);
+
   const typename super::policy_container&
   GetPolicy() const
   {
@@ -331,6 +337,21 @@ ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
     return item->payload();
 }
 
+template<class Policy>
+void
+ContentStoreImpl<Policy>::ForEachUnderPrefix(const Name& prefix,
+                                             const std::function<void(Ptr<const Entry>)>& func)
+{
+  super::for_each_under_prefix(prefix, [&func](Ptr<entry> item) { func(item); });
+}
+
+template<class Policy>
+uint32_t
+ContentStoreImpl<Policy>::CountUnderPrefix(const Name& prefix)
+{
+  return super::count_under_prefix(prefix);
+}
+
 } // namespace cs
 } // namespace ndn
 } // namespace ns3
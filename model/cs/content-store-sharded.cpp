@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "content-store-sharded.hpp"
+
+#include "../../utils/trie/random-policy.hpp"
+#include "../../utils/trie/lru-policy.hpp"
+#include "../../utils/trie/fifo-policy.hpp"
+#include "../../utils/trie/lfu-policy.hpp"
+
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
+  static struct X##type##templ##RegistrationClass {                                                \
+    X##type##templ##RegistrationClass()                                                            \
+    {                                                                                              \
+      ns3::TypeId tid = type<templ>::GetTypeId();                                                  \
+      tid.GetParent();                                                                             \
+    }                                                                                              \
+  } x_##type##templ##RegistrationVariable
+
+namespace ns3 {
+namespace ndn {
+
+using namespace ndnSIM;
+
+namespace cs {
+
+// explicit instantiation and registering
+/**
+ * @brief Sharded ContentStore with LRU cache replacement policy
+ **/
+template class ContentStoreSharded<lru_policy_traits>;
+
+/**
+ * @brief Sharded ContentStore with random cache replacement policy
+ **/
+template class ContentStoreSharded<random_policy_traits>;
+
+/**
+ * @brief Sharded ContentStore with FIFO cache replacement policy
+ **/
+template class ContentStoreSharded<fifo_policy_traits>;
+
+/**
+ * @brief Sharded ContentStore with Least Frequently Used (LFU) cache replacement policy
+ **/
+template class ContentStoreSharded<lfu_policy_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSharded, lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSharded, random_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSharded, fifo_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSharded, lfu_policy_traits);
+
+#ifdef DOXYGEN
+/**
+ * \brief Sharded Content Store implementing LRU cache replacement policy
+ */
+class Sharded::Lru : public ContentStoreSharded<lru_policy_traits> {
+};
+
+/**
+ * \brief Sharded Content Store implementing FIFO cache replacement policy
+ */
+class Sharded::Fifo : public ContentStoreSharded<fifo_policy_traits> {
+};
+
+/**
+ * \brief Sharded Content Store implementing Random cache replacement policy
+ */
+class Sharded::Random : public ContentStoreSharded<random_policy_traits> {
+};
+
+/**
+ * \brief Sharded Content Store implementing Least Frequently Used cache replacement policy
+ */
+class Sharded::Lfu : public ContentStoreSharded<lfu_policy_traits> {
+};
+
+#endif
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,507 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_SHARDED_H_
+#define NDN_CONTENT_STORE_SHARDED_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Cache entry of the sharded content store, remembering the shard it belongs to
+ *
+ * Unlike EntryImpl, the entry does not keep a back-reference to the content store:
+ * ns-3 reference counting is not thread-safe and entries are created concurrently.
+ */
+template<class CS>
+class ShardedEntryImpl : public Entry {
+public:
+  typedef Entry base_type;
+
+public:
+  ShardedEntryImpl(shared_ptr<const Data> data, size_t shard)
+    : Entry(0, data)
+    , item_(0)
+    , shard_(shard)
+  {
+  }
+
+  void
+  SetTrie(typename CS::shard_trie::iterator item)
+  {
+    item_ = item;
+  }
+
+  typename CS::shard_trie::iterator
+  to_iterator()
+  {
+    return item_;
+  }
+
+  typename CS::shard_trie::const_iterator
+  to_iterator() const
+  {
+    return item_;
+  }
+
+  size_t
+  GetShard() const
+  {
+    return shard_;
+  }
+
+private:
+  typename CS::shard_trie::iterator item_;
+  size_t shard_;
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store split into independent trie+policy shards
+ *
+ * Each Data packet is placed into a shard selected by the hash of the first
+ * ShardPrefixLength name components.  Every shard has its own lock, so Add and Lookup
+ * can be called concurrently from several threads (e.g., by a multithreaded simulator
+ * core or parallel per-node processing).  MaxSize is split evenly between shards, so the
+ * global limit is enforced approximately.
+ *
+ * Lookups for Interests that have fewer than ShardPrefixLength components cannot be mapped
+ * to a single shard and fall back to checking all shards.
+ *
+ * Begin/Next/End enumeration is not synchronized and must only be used while no other
+ * thread modifies the store.  Trace sources are fired from the thread calling Add or Lookup.
+ */
+template<class Policy>
+class ContentStoreSharded : public ContentStore {
+public:
+  typedef ndnSIM::
+    trie_with_policy<Name,
+                     ndnSIM::smart_pointer_payload_traits<ShardedEntryImpl<ContentStoreSharded<Policy>>,
+                                                          Entry>,
+                     Policy> shard_trie;
+
+  typedef ShardedEntryImpl<ContentStoreSharded<Policy>> entry;
+
+  static TypeId
+  GetTypeId();
+
+  ContentStoreSharded();
+  virtual ~ContentStoreSharded(){};
+
+  // from ContentStore
+
+  virtual shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual bool
+  Add(shared_ptr<const Data> data);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  virtual uint32_t
+  GetSize() const;
+
+  virtual Ptr<Entry>
+  Begin();
+
+  virtual Ptr<Entry>
+  End();
+
+  virtual Ptr<Entry> Next(Ptr<Entry>);
+
+  /**
+   * @copydoc ContentStore::ForEachUnderPrefix
+   *
+   * The shard lock is held while the function is called
+   */
+  virtual void
+  ForEachUnderPrefix(const Name& prefix, const std::function<void(Ptr<const Entry>)>& func);
+
+  virtual uint32_t
+  CountUnderPrefix(const Name& prefix);
+
+  /**
+   * @brief Get number of shards
+   */
+  uint32_t
+  GetShardCount() const;
+
+  /**
+   * @brief Get index of the shard responsible for the name
+   */
+  size_t
+  GetShardIndex(const Name& name) const;
+
+public:
+  typedef void (*CsEntryCallback)(Ptr<const Entry>);
+
+private:
+  struct Shard {
+    std::mutex mutex;
+    shard_trie trie;
+  };
+
+  shared_ptr<Data>
+  LookupInShard(Shard& shard, const Interest& interest);
+
+  Ptr<Entry>
+  FirstInShard(size_t shardIndex);
+
+  void
+  SetMaxSize(uint32_t maxSize);
+
+  uint32_t
+  GetMaxSize() const;
+
+  void
+  SetShardCount(uint32_t nShards);
+
+  void
+  UpdateShardMaxSize();
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  uint32_t m_maxSize;
+  uint32_t m_shardPrefixLength;
+
+  /// @brief trace of for entry additions (fired every time entry is successfully added to the
+  /// cache): first parameter is pointer to the CS entry
+  TracedCallback<Ptr<const Entry>> m_didAddEntry;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreSharded<Policy>::g_log = LogComponent(("ndn.cs.Sharded."
+                                                                + Policy::GetName()).c_str(), __FILE__);
+
+template<class Policy>
+TypeId
+ContentStoreSharded<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Sharded::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<ContentStore>()
+      .AddConstructor<ContentStoreSharded<Policy>>()
+      .AddAttribute("Shards", "Number of independent trie+policy shards",
+                    UintegerValue(16),
+                    MakeUintegerAccessor(&ContentStoreSharded<Policy>::GetShardCount,
+                                         &ContentStoreSharded<Policy>::SetShardCount),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("ShardPrefixLength",
+                    "Number of leading name components hashed to select the shard",
+                    UintegerValue(1),
+                    MakeUintegerAccessor(&ContentStoreSharded<Policy>::m_shardPrefixLength),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MaxSize",
+                    "Set maximum number of entries in ContentStore (split evenly between shards). "
+                    "If 0, limit is not enforced",
+                    StringValue("100"),
+                    MakeUintegerAccessor(&ContentStoreSharded<Policy>::GetMaxSize,
+                                         &ContentStoreSharded<Policy>::SetMaxSize),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("DidAddEntry",
+                      "Trace fired every time entry is successfully added to the cache",
+                      MakeTraceSourceAccessor(&ContentStoreSharded<Policy>::m_didAddEntry),
+                      "ns3::ndn::cs::ContentStoreSharded::CsEntryCallback");
+
+  return tid;
+}
+
+template<class Policy>
+ContentStoreSharded<Policy>::ContentStoreSharded()
+  : m_maxSize(100)
+  , m_shardPrefixLength(1)
+{
+  SetShardCount(16);
+}
+
+template<class Policy>
+size_t
+ContentStoreSharded<Policy>::GetShardIndex(const Name& name) const
+{
+  size_t seed = 0;
+  size_t nComponents = std::min<size_t>(name.size(), m_shardPrefixLength);
+  for (size_t i = 0; i < nComponents; ++i) {
+    boost::hash_combine(seed, boost::hash_value(name.get(i)));
+  }
+  return seed % m_shards.size();
+}
+
+template<class Policy>
+shared_ptr<Data>
+ContentStoreSharded<Policy>::LookupInShard(Shard& shard, const Interest& interest)
+{
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  typename shard_trie::iterator node;
+  if (interest.getExclude().empty()) {
+    node = shard.trie.deepest_prefix_match(interest.getName());
+  }
+  else {
+    node = shard.trie.deepest_prefix_match_if_next_level(interest.getName(),
+                                                         isNotExcluded(interest.getExclude()));
+  }
+
+  if (node == shard.trie.end())
+    return nullptr;
+
+  return make_shared<Data>(*node->payload()->GetData());
+}
+
+template<class Policy>
+shared_ptr<Data>
+ContentStoreSharded<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  shared_ptr<Data> data;
+  if (interest->getName().size() >= m_shardPrefixLength) {
+    data = LookupInShard(*m_shards[GetShardIndex(interest->getName())], *interest);
+  }
+  else {
+    // the shard cannot be derived from a too short name, any shard can have a match
+    for (auto& shard : m_shards) {
+      data = LookupInShard(*shard, *interest);
+      if (data != nullptr)
+        break;
+    }
+  }
+
+  if (data != nullptr) {
+    this->m_cacheHitsTrace(interest, data);
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+  }
+  return data;
+}
+
+template<class Policy>
+bool
+ContentStoreSharded<Policy>::Add(shared_ptr<const Data> data)
+{
+  NS_LOG_FUNCTION(this << data->getName());
+
+  size_t shardIndex = GetShardIndex(data->getName());
+  Shard& shard = *m_shards[shardIndex];
+
+  // ns-3 reference counting is not thread-safe: the lock must outlive every reference to the
+  // entry held here, including the one released when the entry is rejected or evicted
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  Ptr<entry> newEntry = Create<entry>(data, shardIndex);
+
+  std::pair<typename shard_trie::iterator, bool> result =
+    shard.trie.insert(data->getName(), newEntry);
+
+  if (result.first != shard.trie.end() && result.second) {
+    newEntry->SetTrie(result.first);
+
+    m_didAddEntry(newEntry);
+    return true;
+  }
+  return false;
+}
+
+template<class Policy>
+void
+ContentStoreSharded<Policy>::Print(std::ostream& os) const
+{
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    const typename shard_trie::policy_container& policy = shard->trie.getPolicy();
+    for (typename shard_trie::policy_container::const_iterator item = policy.begin();
+         item != policy.end(); item++) {
+      os << item->payload()->GetName() << std::endl;
+    }
+  }
+}
+
+template<class Policy>
+void
+ContentStoreSharded<Policy>::SetMaxSize(uint32_t maxSize)
+{
+  m_maxSize = maxSize;
+  UpdateShardMaxSize();
+}
+
+template<class Policy>
+uint32_t
+ContentStoreSharded<Policy>::GetMaxSize() const
+{
+  return m_maxSize;
+}
+
+template<class Policy>
+void
+ContentStoreSharded<Policy>::SetShardCount(uint32_t nShards)
+{
+  NS_ASSERT_MSG(nShards > 0, "Sharded content store needs at least one shard");
+  NS_ASSERT_MSG(GetSize() == 0, "Number of shards can only be changed while the store is empty");
+
+  m_shards.clear();
+  for (uint32_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(make_unique<Shard>());
+  }
+  UpdateShardMaxSize();
+}
+
+template<class Policy>
+uint32_t
+ContentStoreSharded<Policy>::GetShardCount() const
+{
+  return m_shards.size();
+}
+
+template<class Policy>
+void
+ContentStoreSharded<Policy>::UpdateShardMaxSize()
+{
+  // round up, so that a small store does not end up with zero-size (unlimited) shards
+  size_t shardMaxSize = 0;
+  if (m_maxSize != 0) {
+    shardMaxSize = (m_maxSize + m_shards.size() - 1) / m_shards.size();
+  }
+
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->trie.getPolicy().set_max_size(shardMaxSize);
+  }
+}
+
+template<class Policy>
+uint32_t
+ContentStoreSharded<Policy>::GetSize() const
+{
+  uint32_t size = 0;
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->trie.getPolicy().size();
+  }
+  return size;
+}
+
+template<class Policy>
+void
+ContentStoreSharded<Policy>::ForEachUnderPrefix(const Name& prefix,
+                                                const std::function<void(Ptr<const Entry>)>& func)
+{
+  auto visit = [&func](Ptr<entry> item) { func(item); };
+
+  if (prefix.size() >= m_shardPrefixLength) {
+    Shard& shard = *m_shards[GetShardIndex(prefix)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.trie.for_each_under_prefix(prefix, visit);
+    return;
+  }
+
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->trie.for_each_under_prefix(prefix, visit);
+  }
+}
+
+template<class Policy>
+uint32_t
+ContentStoreSharded<Policy>::CountUnderPrefix(const Name& prefix)
+{
+  if (prefix.size() >= m_shardPrefixLength) {
+    Shard& shard = *m_shards[GetShardIndex(prefix)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.trie.count_under_prefix(prefix);
+  }
+
+  uint32_t count = 0;
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    count += shard->trie.count_under_prefix(prefix);
+  }
+  return count;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreSharded<Policy>::FirstInShard(size_t shardIndex)
+{
+  for (; shardIndex < m_shards.size(); ++shardIndex) {
+    typename shard_trie::parent_trie::recursive_iterator item(m_shards[shardIndex]->trie.getTrie()),
+      end(0);
+    for (; item != end; item++) {
+      if (item->payload() != 0)
+        return item->payload();
+    }
+  }
+  return End();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreSharded<Policy>::Begin()
+{
+  return FirstInShard(0);
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreSharded<Policy>::End()
+{
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreSharded<Policy>::Next(Ptr<Entry> from)
+{
+  if (from == 0)
+    return 0;
+
+  Ptr<entry> fromEntry = StaticCast<entry>(from);
+  typename shard_trie::parent_trie::recursive_iterator item(*fromEntry->to_iterator()), end(0);
+
+  for (item++; item != end; item++) {
+    if (item->payload() != 0)
+      return item->payload();
+  }
+
+  return FirstInShard(fromEntry->GetShard() + 1);
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_SHARDED_H_
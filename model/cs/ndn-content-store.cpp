@@ -52,6 +52,24 @@ ContentStore::~ContentStore()
 {
 }
 
+void
+ContentStore::ForEachUnderPrefix(const Name& prefix,
+                                 const std::function<void(Ptr<const cs::Entry>)>& func)
+{
+  for (Ptr<cs::Entry> entry = Begin(); entry != End(); entry = Next(entry)) {
+    if (prefix.isPrefixOf(entry->GetName()))
+      func(entry);
+  }
+}
+
+uint32_t
+ContentStore::CountUnderPrefix(const Name& prefix)
+{
+  uint32_t count = 0;
+  ForEachUnderPrefix(prefix, [&count](Ptr<const cs::Entry>) { ++count; });
+  return count;
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
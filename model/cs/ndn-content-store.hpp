@@ -26,6 +26,7 @@
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
 
+#include <functional>
 #include <tuple>
 
 namespace ns3 {
@@ -168,6 +169,25 @@ public:
    */
   virtual Ptr<cs::Entry> Next(Ptr<cs::Entry>) = 0;
 
+  /**
+   * @brief Call function for every entry, name of which starts with the prefix (no order
+   *        guaranteed)
+   *
+   * Default implementation enumerates all entries; trie-based content stores only walk the
+   * subtree of the prefix.  The function must not modify the content store.
+   */
+  virtual void
+  ForEachUnderPrefix(const Name& prefix, const std::function<void(Ptr<const cs::Entry>)>& func);
+
+  /**
+   * @brief Get number of entries, name of which starts with the prefix
+   *
+   * Trie-based content stores answer in O(prefix length), making this call suitable for
+   * existence checks
+   */
+  virtual uint32_t
+  CountUnderPrefix(const Name& prefix);
+
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,473 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-content-trigger-engine.hpp"
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ContentTriggerEngine");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ContentTriggerEngine);
+
+static Ptr<ContentTriggerEngine> g_engine;
+
+TypeId
+ContentTriggerEngine::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ContentTriggerEngine")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<ContentTriggerEngine>()
+      .AddAttribute("Period", "Period of zone movement and membership updates",
+                    StringValue("1s"), MakeTimeAccessor(&ContentTriggerEngine::m_period),
+                    MakeTimeChecker())
+      .AddAttribute("CellSize", "Size of the cells of the grid index over node positions (m)",
+                    DoubleValue(100.0), MakeDoubleAccessor(&ContentTriggerEngine::m_cellSize),
+                    MakeDoubleChecker<double>(0.0));
+  return tid;
+}
+
+Ptr<ContentTriggerEngine>
+ContentTriggerEngine::Get()
+{
+  if (g_engine == nullptr) {
+    g_engine = CreateObject<ContentTriggerEngine>();
+    Simulator::ScheduleDestroy(&ContentTriggerEngine::Destroy);
+  }
+  return g_engine;
+}
+
+void
+ContentTriggerEngine::Destroy()
+{
+  if (g_engine != nullptr) {
+    g_engine->Dispose();
+    g_engine = nullptr;
+  }
+}
+
+ContentTriggerEngine::ContentTriggerEngine()
+  : m_period(Seconds(1))
+  , m_cellSize(100.0)
+  , m_lastWatchId(0)
+{
+}
+
+void
+ContentTriggerEngine::DoDispose()
+{
+  m_tickTimers.clear();
+
+  for (auto& node : m_nodes) {
+    node.second.mobility->TraceDisconnectWithoutContext("CourseChange", MakeCourseChangeCallback());
+  }
+  m_nodes.clear();
+  m_nodeByMobility.clear();
+  m_grid.clear();
+  m_rebin = decltype(m_rebin)();
+  m_watchers.clear();
+  m_zones.clear();
+  m_zoneIds.clear();
+
+  Object::DoDispose();
+}
+
+ContentTriggerEngine::Zone
+ContentTriggerEngine::MakeRoadZone(double xStart, double xEnd, double xSpeed, Time start, Time end,
+                                   Time epoch)
+{
+  Zone zone;
+  zone.xMin = xStart;
+  zone.xMax = xEnd;
+  zone.xSpeed = xSpeed;
+  zone.start = start;
+  zone.end = end;
+  zone.epoch = epoch;
+  return zone;
+}
+
+uint32_t
+ContentTriggerEngine::AddZone(const Zone& zone)
+{
+  std::vector<double> key = {zone.xMin, zone.xMax, zone.yMin, zone.yMax, zone.xSpeed,
+                             zone.ySpeed, zone.start.GetDouble(), zone.end.GetDouble(),
+                             zone.epoch.GetDouble()};
+  auto existing = m_zoneIds.find(key);
+  if (existing != m_zoneIds.end())
+    return existing->second;
+
+  uint32_t zoneId = m_zones.size();
+  m_zones.push_back(ZoneState());
+  m_zones.back().zone = zone;
+  m_zoneIds[key] = zoneId;
+
+  NS_LOG_DEBUG("Zone " << zoneId << ": x [" << zone.xMin << ", " << zone.xMax << "), y ["
+               << zone.yMin << ", " << zone.yMax << "), active [" << zone.start.GetSeconds()
+               << "s, " << zone.end.GetSeconds() << "s), moving from "
+               << zone.epoch.GetSeconds() << "s");
+  return zoneId;
+}
+
+int64_t
+ContentTriggerEngine::GetTickIndex(Time time, Time epoch) const
+{
+  return (time - epoch).GetTimeStep() / m_period.GetTimeStep();
+}
+
+int64_t
+ContentTriggerEngine::GetTickPhase(Time epoch) const
+{
+  int64_t period = m_period.GetTimeStep();
+  return (epoch.GetTimeStep() % period + period) % period;
+}
+
+ContentTriggerEngine::Zone
+ContentTriggerEngine::GetZoneAt(const ZoneState& state, int64_t nMoves) const
+{
+  Zone zone = state.zone;
+  double dx = zone.xSpeed * m_period.GetSeconds() * nMoves;
+  double dy = zone.ySpeed * m_period.GetSeconds() * nMoves;
+  zone.xMin += dx;
+  zone.xMax += dx;
+  zone.yMin += dy;
+  zone.yMax += dy;
+  return zone;
+}
+
+ContentTriggerEngine::Zone
+ContentTriggerEngine::GetZone(uint32_t zoneId) const
+{
+  const ZoneState& state = m_zones.at(zoneId);
+  int64_t nMoves = GetTickIndex(Simulator::Now(), state.zone.epoch);
+  return GetZoneAt(state, std::max<int64_t>(nMoves, 0));
+}
+
+Vector
+ContentTriggerEngine::GetZoneCenter(uint32_t zoneId) const
+{
+  Zone zone = GetZone(zoneId);
+  auto center = [] (double min, double max) {
+    return std::isinf(min) || std::isinf(max) ? 0.0 : (min + max) / 2;
+  };
+  return Vector(center(zone.xMin, zone.xMax), center(zone.yMin, zone.yMax), 0);
+}
+
+size_t
+ContentTriggerEngine::GetMemberCount(uint32_t zoneId) const
+{
+  return m_zones.at(zoneId).members.size();
+}
+
+uint64_t
+ContentTriggerEngine::Watch(uint32_t zoneId, Ptr<Node> node, const ZoneCallback& callback)
+{
+  NS_ASSERT(zoneId < m_zones.size());
+
+  uint64_t watchId = ++m_lastWatchId;
+  m_watchers[watchId] = Watcher{zoneId, node->GetId(), callback};
+  m_zones[zoneId].watches[node->GetId()].push_back(watchId);
+  Track(node->GetId(), node);
+
+  UpdateTickTimers();
+  return watchId;
+}
+
+void
+ContentTriggerEngine::Unwatch(uint64_t watchId)
+{
+  auto watcher = m_watchers.find(watchId);
+  if (watcher == m_watchers.end())
+    return;
+
+  ZoneState& state = m_zones[watcher->second.zoneId];
+  uint32_t nodeId = watcher->second.nodeId;
+  std::vector<uint64_t>& watches = state.watches[nodeId];
+  watches.erase(std::find(watches.begin(), watches.end(), watchId));
+  if (watches.empty()) {
+    state.watches.erase(nodeId);
+    state.members.erase(nodeId);
+  }
+
+  m_watchers.erase(watcher);
+  Untrack(nodeId);
+}
+
+int64_t
+ContentTriggerEngine::GetCellIndex(double coordinate) const
+{
+  // unbounded zones span all cells, while indices stay far from overflow
+  const double limit = 1e15;
+  double cell = std::floor(coordinate / m_cellSize);
+  return static_cast<int64_t>(std::max(-limit, std::min(limit, cell)));
+}
+
+ContentTriggerEngine::Cell
+ContentTriggerEngine::GetCell(const Vector& position) const
+{
+  return Cell(GetCellIndex(position.x), GetCellIndex(position.y));
+}
+
+void
+ContentTriggerEngine::Track(uint32_t nodeId, Ptr<Node> node)
+{
+  auto tracked = m_nodes.find(nodeId);
+  if (tracked != m_nodes.end()) {
+    tracked->second.nWatches++;
+    return;
+  }
+
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+  if (mobility == nullptr) {
+    NS_FATAL_ERROR("Node " << nodeId << " watches a content trigger, but has no MobilityModel");
+  }
+
+  TrackedNode& newNode = m_nodes[nodeId];
+  newNode.mobility = mobility;
+  newNode.nWatches = 1;
+  m_nodeByMobility[PeekPointer(mobility)] = nodeId;
+  mobility->TraceConnectWithoutContext("CourseChange", MakeCourseChangeCallback());
+  Bin(nodeId, newNode);
+}
+
+void
+ContentTriggerEngine::Untrack(uint32_t nodeId)
+{
+  auto tracked = m_nodes.find(nodeId);
+  if (tracked == m_nodes.end() || --tracked->second.nWatches > 0)
+    return;
+
+  Unbin(nodeId, tracked->second);
+  tracked->second.mobility->TraceDisconnectWithoutContext("CourseChange",
+                                                          MakeCourseChangeCallback());
+  m_nodeByMobility.erase(PeekPointer(tracked->second.mobility));
+  m_nodes.erase(tracked);
+}
+
+void
+ContentTriggerEngine::Bin(uint32_t nodeId, TrackedNode& tracked)
+{
+  Vector position = tracked.mobility->GetPosition();
+  Vector velocity = tracked.mobility->GetVelocity();
+  tracked.cell = GetCell(position);
+  m_grid[tracked.cell].insert(nodeId);
+
+  // time until the node can cross the boundary of its cell, assuming constant velocity
+  auto crossing = [this] (double position, double speed, int64_t cell) {
+    if (speed > 0)
+      return ((cell + 1) * m_cellSize - position) / speed;
+    if (speed < 0)
+      return (position - cell * m_cellSize) / -speed;
+    return std::numeric_limits<double>::infinity();
+  };
+  double dt = std::min(crossing(position.x, velocity.x, tracked.cell.first),
+                       crossing(position.y, velocity.y, tracked.cell.second));
+
+  Time now = Simulator::Now();
+  if (dt > 1e9) { // until the course changes
+    tracked.validUntil = Time::Max();
+    return;
+  }
+
+  tracked.validUntil = std::max(now + Seconds(dt), now + TimeStep(1));
+  m_rebin.push(std::make_pair(tracked.validUntil, nodeId));
+}
+
+void
+ContentTriggerEngine::Unbin(uint32_t nodeId, const TrackedNode& tracked)
+{
+  auto cell = m_grid.find(tracked.cell);
+  cell->second.erase(nodeId);
+  if (cell->second.empty()) {
+    m_grid.erase(cell);
+  }
+}
+
+Callback<void, Ptr<const MobilityModel>>
+ContentTriggerEngine::MakeCourseChangeCallback()
+{
+  return MakeCallback(&ContentTriggerEngine::OnCourseChange, this);
+}
+
+void
+ContentTriggerEngine::OnCourseChange(Ptr<const MobilityModel> mobility)
+{
+  auto nodeId = m_nodeByMobility.find(PeekPointer(mobility));
+  if (nodeId == m_nodeByMobility.end())
+    return;
+
+  TrackedNode& tracked = m_nodes[nodeId->second];
+  Unbin(nodeId->second, tracked);
+  Bin(nodeId->second, tracked);
+}
+
+void
+ContentTriggerEngine::UpdateTickTimers()
+{
+  Time now = Simulator::Now();
+  std::set<int64_t> phases;
+  for (const ZoneState& state : m_zones) {
+    if (!state.watches.empty() && (state.zone.end > now || !state.members.empty())) {
+      phases.insert(GetTickPhase(state.zone.epoch));
+    }
+  }
+
+  for (auto& timer : m_tickTimers) {
+    if (phases.count(timer.first) == 0) {
+      timer.second.Stop();
+    }
+  }
+
+  int64_t period = m_period.GetTimeStep();
+  for (int64_t phase : phases) {
+    auto timer = m_tickTimers.find(phase);
+    if (timer == m_tickTimers.end()) {
+      timer = m_tickTimers.emplace(std::piecewise_construct, std::forward_as_tuple(phase),
+                                   std::forward_as_tuple([this, phase] { Tick(phase); })).first;
+    }
+    if (timer->second.IsRunning())
+      continue;
+
+    // first tick of the phase after now
+    int64_t sinceTick = now.GetTimeStep() - phase;
+    int64_t next = phase + (sinceTick >= 0 ? (sinceTick / period + 1) * period : 0);
+    timer->second.StartAt(TimeStep(next), m_period);
+  }
+}
+
+void
+ContentTriggerEngine::Tick(int64_t phase)
+{
+  Time now = Simulator::Now();
+
+  // nodes that may have left their cells (timers are not removed on course change)
+  while (!m_rebin.empty() && m_rebin.top().first <= now) {
+    std::pair<Time, uint32_t> item = m_rebin.top();
+    m_rebin.pop();
+
+    auto tracked = m_nodes.find(item.second);
+    if (tracked == m_nodes.end() || tracked->second.validUntil != item.first)
+      continue;
+
+    Unbin(item.second, tracked->second);
+    Bin(item.second, tracked->second);
+  }
+
+  for (uint32_t zoneId = 0; zoneId < m_zones.size(); zoneId++) {
+    ZoneState& state = m_zones[zoneId];
+    if (state.watches.empty() || GetTickPhase(state.zone.epoch) != phase)
+      continue;
+
+    int64_t tick = GetTickIndex(now, state.zone.epoch);
+    if (tick <= 0)
+      continue;
+
+    // zones are evaluated before they move at the tick
+    UpdateZone(zoneId, state, tick - 1, now);
+  }
+
+  UpdateTickTimers();
+}
+
+void
+ContentTriggerEngine::UpdateZone(uint32_t zoneId, ZoneState& state, int64_t nMoves, Time now)
+{
+  Zone zone = GetZoneAt(state, nMoves);
+
+  std::set<uint32_t> members;
+  if (zone.start <= now && now < zone.end) {
+    int64_t xMin = GetCellIndex(zone.xMin);
+    int64_t xMax = GetCellIndex(zone.xMax);
+    int64_t yMin = GetCellIndex(zone.yMin);
+    int64_t yMax = GetCellIndex(zone.yMax);
+
+    // only occupied cells are visited, column by column
+    auto cell = m_grid.lower_bound(Cell(xMin, yMin));
+    while (cell != m_grid.end() && cell->first.first <= xMax) {
+      if (cell->first.second < yMin) {
+        cell = m_grid.lower_bound(Cell(cell->first.first, yMin));
+        continue;
+      }
+      if (cell->first.second > yMax) {
+        cell = m_grid.lower_bound(Cell(cell->first.first + 1, yMin));
+        continue;
+      }
+
+      for (uint32_t nodeId : cell->second) {
+        if (state.watches.count(nodeId) == 0)
+          continue;
+
+        Vector position = m_nodes[nodeId].mobility->GetPosition();
+        if (zone.xMin <= position.x && position.x < zone.xMax && zone.yMin <= position.y
+            && position.y < zone.yMax) {
+          members.insert(nodeId);
+        }
+      }
+      ++cell;
+    }
+  }
+
+  std::vector<std::pair<ZoneCallback, bool>> callbacks;
+  auto notify = [&] (uint32_t nodeId, bool isInside) {
+    auto watches = state.watches.find(nodeId);
+    if (watches == state.watches.end())
+      return;
+    for (uint64_t watchId : watches->second) {
+      callbacks.push_back(std::make_pair(m_watchers.at(watchId).callback, isInside));
+    }
+  };
+
+  std::vector<uint32_t> changed;
+  std::set_difference(members.begin(), members.end(), state.members.begin(),
+                      state.members.end(), std::back_inserter(changed));
+  for (uint32_t nodeId : changed) {
+    NS_LOG_DEBUG("Node " << nodeId << " entered zone " << zoneId);
+    notify(nodeId, true);
+  }
+
+  changed.clear();
+  std::set_difference(state.members.begin(), state.members.end(), members.begin(),
+                      members.end(), std::back_inserter(changed));
+  for (uint32_t nodeId : changed) {
+    NS_LOG_DEBUG("Node " << nodeId << " left zone " << zoneId);
+    notify(nodeId, false);
+  }
+
+  state.members.swap(members);
+
+  // callbacks are allowed to (un)watch
+  for (const auto& callback : callbacks) {
+    callback.first(callback.second);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
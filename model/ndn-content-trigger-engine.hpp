@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_TRIGGER_ENGINE_H
+#define NDN_CONTENT_TRIGGER_ENGINE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-periodic-timer.hpp"
+
+#include "ns3/object.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+class MobilityModel;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Scenario-wide content triggers: moving 2D zones, where content (e.g., a hazard) can be
+ *        sensed by the nodes inside
+ *
+ * Every zone moves by its speed times the tick period at each whole tick period after its epoch
+ * (the time the apps that added it started), as the per-app polling loops did.  Just before
+ * moving, the engine computes which watching nodes are inside each active zone and notifies only
+ * the nodes that entered or left it.  Zones whose ticks fall at the same times share one
+ * PeriodicTimer.
+ *
+ * Watched nodes are kept in a uniform grid of CellSize x CellSize cells.  A node is re-binned
+ * only when it may have crossed its cell (computed from its velocity) or after its course
+ * changes, and membership is tested only for the nodes in the cells a zone overlaps.  The cost
+ * of a tick thus depends on the nodes near the zones, not on the number of nodes.
+ *
+ * The engine is created on first use and destroyed together with the simulator.
+ */
+class ContentTriggerEngine : public Object {
+public:
+  /**
+   * @brief Rectangular zone [xMin, xMax) x [yMin, yMax), active during [start, end)
+   */
+  struct Zone {
+    double xMin = 0;
+    double xMax = 0;
+    double yMin = -std::numeric_limits<double>::infinity();
+    double yMax = std::numeric_limits<double>::infinity();
+    double xSpeed = 0; ///< @brief m/s
+    double ySpeed = 0; ///< @brief m/s
+    Time start;
+    Time end;
+    Time epoch; ///< @brief the zone moves at epoch + k * period, k >= 1
+  };
+
+  /**
+   * @brief Called with true when the node enters the zone and with false when it leaves it
+   *        (or the zone stops being active)
+   */
+  typedef std::function<void(bool isInside)> ZoneCallback;
+
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get (create if necessary) the engine of the simulation
+   */
+  static Ptr<ContentTriggerEngine>
+  Get();
+
+  /**
+   * @brief Destroy the engine of the simulation
+   */
+  static void
+  Destroy();
+
+  ContentTriggerEngine();
+
+  /**
+   * @brief Zone spanning all y, as configured by the CTx and CTl attributes of the apps
+   */
+  static Zone
+  MakeRoadZone(double xStart, double xEnd, double xSpeed, Time start, Time end,
+               Time epoch = Seconds(0));
+
+  /**
+   * @brief Add zone, which starts moving at its epoch
+   * @return zone ID; adding an identical zone (including the epoch) returns the ID of the
+   *         existing one
+   */
+  uint32_t
+  AddZone(const Zone& zone);
+
+  /**
+   * @brief Get the zone with its current position
+   */
+  Zone
+  GetZone(uint32_t zoneId) const;
+
+  /**
+   * @brief Get center of the zone at its current position
+   */
+  Vector
+  GetZoneCenter(uint32_t zoneId) const;
+
+  /**
+   * @brief Notify when the node (which must have a MobilityModel) enters or leaves the zone
+   * @return watch ID to be used with Unwatch
+   */
+  uint64_t
+  Watch(uint32_t zoneId, Ptr<Node> node, const ZoneCallback& callback);
+
+  /**
+   * @brief Cancel watch created by Watch
+   */
+  void
+  Unwatch(uint64_t watchId);
+
+  /**
+   * @brief Number of nodes inside the zone, as of the last tick
+   */
+  size_t
+  GetMemberCount(uint32_t zoneId) const;
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  typedef std::pair<int64_t, int64_t> Cell;
+
+  /// @cond include_hidden
+  struct ZoneState {
+    Zone zone; ///< @brief position at the epoch
+    std::map<uint32_t, std::vector<uint64_t>> watches; ///< @brief node ID => watch IDs
+    std::set<uint32_t> members;                        ///< @brief node IDs inside
+  };
+
+  struct Watcher {
+    uint32_t zoneId;
+    uint32_t nodeId;
+    ZoneCallback callback;
+  };
+
+  struct TrackedNode {
+    Ptr<MobilityModel> mobility;
+    Cell cell;
+    Time validUntil; ///< @brief the node cannot leave its cell before
+    size_t nWatches = 0;
+  };
+  /// @endcond
+
+  Zone
+  GetZoneAt(const ZoneState& state, int64_t nMoves) const;
+
+  /**
+   * @brief Number of whole tick periods between @p epoch and @p time
+   */
+  int64_t
+  GetTickIndex(Time time, Time epoch) const;
+
+  /**
+   * @brief Offset of ticks of zones with the epoch into the period, in time steps
+   */
+  int64_t
+  GetTickPhase(Time epoch) const;
+
+  Cell
+  GetCell(const Vector& position) const;
+
+  int64_t
+  GetCellIndex(double coordinate) const;
+
+  void
+  Track(uint32_t nodeId, Ptr<Node> node);
+
+  void
+  Untrack(uint32_t nodeId);
+
+  void
+  Bin(uint32_t nodeId, TrackedNode& tracked);
+
+  void
+  Unbin(uint32_t nodeId, const TrackedNode& tracked);
+
+  Callback<void, Ptr<const MobilityModel>>
+  MakeCourseChangeCallback();
+
+  void
+  OnCourseChange(Ptr<const MobilityModel> mobility);
+
+  /**
+   * @brief Start tick timers of the watched zones that are or may become active, stop the rest
+   */
+  void
+  UpdateTickTimers();
+
+  void
+  Tick(int64_t phase);
+
+  void
+  UpdateZone(uint32_t zoneId, ZoneState& state, int64_t nMoves, Time now);
+
+private:
+  Time m_period;
+  double m_cellSize;
+  std::map<int64_t, PeriodicTimer> m_tickTimers; ///< @brief tick phase => timer
+
+  std::vector<ZoneState> m_zones;
+  std::map<std::vector<double>, uint32_t> m_zoneIds; ///< @brief zone parameters => zone ID
+
+  std::unordered_map<uint64_t, Watcher> m_watchers;
+  uint64_t m_lastWatchId;
+
+  std::unordered_map<uint32_t, TrackedNode> m_nodes;
+  std::unordered_map<const MobilityModel*, uint32_t> m_nodeByMobility;
+  std::map<Cell, std::set<uint32_t>> m_grid; ///< @brief ordered by x cell, then y cell
+  std::priority_queue<std::pair<Time, uint32_t>, std::vector<std::pair<Time, uint32_t>>,
+                      std::greater<std::pair<Time, uint32_t>>> m_rebin;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_TRIGGER_ENGINE_H
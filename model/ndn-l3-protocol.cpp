@@ -33,6 +33,7 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
+#include "../utils/tracers/ndn-trace-filter.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
 
@@ -194,6 +195,10 @@ private:
 
   Ptr<ContentStore> m_csFromNdnSim;
   PolicyCreationCallback m_policy;
+
+  std::map<Name, std::map<uint64_t, ContentArrivalCallback>> m_contentWatches;
+  std::map<uint64_t, Name> m_contentWatchPrefixes;
+  uint64_t m_lastContentWatchId = 0;
 };
 
 L3Protocol::L3Protocol()
@@ -220,8 +225,18 @@ L3Protocol::initialize()
   initializeManagement();
   initializeRibManager();
 
-  m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
-  m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
+  m_impl->m_forwarder->beforeSatisfyInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data) {
+      if (this->isTraced(pitEntry.getName())) {
+        this->m_satisfiedInterests(pitEntry, inFace, data);
+      }
+    });
+  m_impl->m_forwarder->beforeExpirePendingInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry) {
+      if (this->isTraced(pitEntry.getName())) {
+        this->m_timedOutInterests(pitEntry);
+      }
+    });
 }
 
 class IgnoreSections
@@ -257,6 +272,138 @@ L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
   m_impl->m_policy = policy;
 }
 
+uint64_t
+L3Protocol::watchPrefix(const Name& prefix, const ContentArrivalCallback& callback)
+{
+  uint64_t watchId = ++m_impl->m_lastContentWatchId;
+  m_impl->m_contentWatches[prefix][watchId] = callback;
+  m_impl->m_contentWatchPrefixes[watchId] = prefix;
+  return watchId;
+}
+
+void
+L3Protocol::unwatchPrefix(uint64_t watchId)
+{
+  if (m_impl == nullptr) // already disposed
+    return;
+
+  auto prefix = m_impl->m_contentWatchPrefixes.find(watchId);
+  if (prefix == m_impl->m_contentWatchPrefixes.end())
+    return;
+
+  auto watches = m_impl->m_contentWatches.find(prefix->second);
+  watches->second.erase(watchId);
+  if (watches->second.empty()) {
+    m_impl->m_contentWatches.erase(watches);
+  }
+  m_impl->m_contentWatchPrefixes.erase(prefix);
+}
+
+void
+L3Protocol::cacheData(const Data& data, bool isUnsolicited)
+{
+  if (m_impl->m_csFromNdnSim != nullptr) {
+    m_impl->m_csFromNdnSim->Add(make_shared<Data>(data));
+  }
+  else {
+    m_impl->m_forwarder->getCs().insert(data, isUnsolicited);
+  }
+
+  notifyContentArrival(data);
+}
+
+size_t
+L3Protocol::pushData(const Data& data, const std::vector<nfd::FaceId>& faceIds)
+{
+  size_t nSent = 0;
+  for (nfd::FaceId faceId : faceIds) {
+    Face* face = m_impl->m_forwarder->getFaceTable().get(faceId);
+    if (face == nullptr || face->getScope() == ::ndn::nfd::FACE_SCOPE_LOCAL)
+      continue;
+
+    face->sendData(data);
+    nSent++;
+  }
+  return nSent;
+}
+
+size_t
+L3Protocol::pushData(const Data& data)
+{
+  size_t nSent = 0;
+  for (auto& face : m_impl->m_forwarder->getFaceTable()) {
+    if (dynamic_cast<NetDeviceTransport*>(face.getTransport()) == nullptr)
+      continue;
+
+    face.sendData(data);
+    nSent++;
+  }
+  return nSent;
+}
+
+void
+L3Protocol::setTraceFilter(Ptr<TraceFilter> filter)
+{
+  m_traceFilter = filter;
+}
+
+Ptr<TraceFilter>
+L3Protocol::getTraceFilter() const
+{
+  return m_traceFilter;
+}
+
+bool
+L3Protocol::isTraced(const Name& name) const
+{
+  return m_traceFilter == nullptr || m_traceFilter->IsTraced(name);
+}
+
+void
+L3Protocol::notifyContentArrival(const Data& data)
+{
+  if (m_impl->m_contentWatches.empty())
+    return;
+
+  // cost depends only on the name length and the number of watched prefixes, not on CS size
+  std::vector<ContentArrivalCallback> callbacks;
+  const Name& name = data.getName();
+  for (size_t prefixLength = 0; prefixLength <= name.size(); ++prefixLength) {
+    auto watches = m_impl->m_contentWatches.find(name.getPrefix(prefixLength));
+    if (watches == m_impl->m_contentWatches.end())
+      continue;
+
+    for (const auto& watch : watches->second) {
+      callbacks.push_back(watch.second);
+    }
+  }
+
+  if (callbacks.empty() || !isCached(data))
+    return;
+
+  // callbacks are allowed to (un)subscribe
+  for (const auto& callback : callbacks) {
+    callback(data);
+  }
+}
+
+bool
+L3Protocol::isCached(const Data& data) const
+{
+  if (m_impl->m_csFromNdnSim != nullptr) {
+    return m_impl->m_csFromNdnSim->CountUnderPrefix(data.getName()) > 0;
+  }
+
+  Interest interest(data.getName());
+  interest.setCanBePrefix(false);
+
+  bool isFound = false;
+  m_impl->m_forwarder->getCs().find(interest,
+                                    [&isFound](const Interest&, const Data&) { isFound = true; },
+                                    [](const Interest&) {});
+  return isFound;
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -394,6 +541,7 @@ L3Protocol::DoDispose(void)
   nfd::scheduler::resetGlobalScheduler();
 
   m_node = 0;
+  m_traceFilter = 0;
 
   Object::DoDispose();
 }
@@ -410,21 +558,25 @@ L3Protocol::addFace(shared_ptr<Face> face)
   // // Connect Signals to TraceSource
   face->afterReceiveInterest.connect([this, weakFace](const Interest& interest) {
       shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
+      if (face != nullptr && this->isTraced(interest.getName())) {
         this->m_inInterests(interest, *face);
       }
     });
 
+  // connected after the forwarder, so Data is already processed (and cached) when called
   face->afterReceiveData.connect([this, weakFace](const Data& data) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
-        this->m_inData(data, *face);
+        if (this->isTraced(data.getName())) {
+          this->m_inData(data, *face);
+        }
+        this->notifyContentArrival(data);
       }
     });
 
   face->afterReceiveNack.connect([this, weakFace](const lp::Nack& nack) {
       shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
+      if (face != nullptr && this->isTraced(nack.getInterest().getName())) {
         this->m_inNack(nack, *face);
       }
     });
@@ -433,21 +585,21 @@ L3Protocol::addFace(shared_ptr<Face> face)
   NS_LOG_LOGIC("Adding trace sources for afterSendInterest and afterSendData");
   tracingLink->afterSendInterest.connect([this, weakFace](const Interest& interest) {
       shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
+      if (face != nullptr && this->isTraced(interest.getName())) {
         this->m_outInterests(interest, *face);
       }
     });
 
   tracingLink->afterSendData.connect([this, weakFace](const Data& data) {
       shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
+      if (face != nullptr && this->isTraced(data.getName())) {
         this->m_outData(data, *face);
       }
     });
 
   tracingLink->afterSendNack.connect([this, weakFace](const lp::Nack& nack) {
       shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
+      if (face != nullptr && this->isTraced(nack.getInterest().getName())) {
         this->m_outNack(nack, *face);
       }
     });
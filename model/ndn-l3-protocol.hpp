@@ -56,6 +56,8 @@ class Header;
 
 namespace ndn {
 
+class TraceFilter;
+
 /**
  * \defgroup ndn ndnSIM: NDN simulation module
  *
@@ -170,6 +172,68 @@ public:
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
 
+  typedef std::function<void(const Data&)> ContentArrivalCallback;
+
+  /**
+   * \brief Subscribe to Data packets under the prefix that get cached on the node
+   *
+   * The callback is invoked right after a Data packet received on any face, or added using
+   * cacheData(), is inserted into the node's content store.
+   *
+   * \return watch ID to be used with unwatchPrefix
+   */
+  uint64_t
+  watchPrefix(const Name& prefix, const ContentArrivalCallback& callback);
+
+  /**
+   * \brief Cancel subscription created by watchPrefix
+   */
+  void
+  unwatchPrefix(uint64_t watchId);
+
+  /**
+   * \brief Insert Data directly into the node's content store, notifying prefix watchers
+   */
+  void
+  cacheData(const Data& data, bool isUnsolicited = false);
+
+  /**
+   * \brief Send unsolicited Data directly on the given faces, bypassing the forwarder
+   *
+   * Faces that do not exist or are local (application, internal) are skipped.  The Data is not
+   * cached; use cacheData() for that.
+   *
+   * \return number of faces the Data was sent on
+   */
+  size_t
+  pushData(const Data& data, const std::vector<nfd::FaceId>& faceIds);
+
+  /**
+   * \brief Send unsolicited Data directly on all faces backed by a NetDevice (e.g., the
+   *        broadcast wireless face), bypassing the forwarder
+   *
+   * \return number of faces the Data was sent on
+   */
+  size_t
+  pushData(const Data& data);
+
+  /**
+   * \brief Set filter of the packets reported by the trace sources (nullptr to report all)
+   *
+   * \see TraceFilter
+   */
+  void
+  setTraceFilter(Ptr<TraceFilter> filter);
+
+  Ptr<TraceFilter>
+  getTraceFilter() const;
+
+  /**
+   * \brief Check whether the trace sources report packets with the name
+   */
+  bool
+  isTraced(const Name& name) const;
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -204,6 +268,12 @@ private:
   void
   initializeRibManager();
 
+  void
+  notifyContentArrival(const Data& data);
+
+  bool
+  isCached(const Data& data) const;
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -211,6 +281,8 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
+  Ptr<TraceFilter> m_traceFilter; ///< \brief nullptr if all packets are reported
+
   TracedCallback<const Interest&, const Face&>
     m_inInterests; ///< @brief trace of incoming Interests
   TracedCallback<const Interest&, const Face&>
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rsu-coordinator.hpp"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RsuCoordinator");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct Region {
+  size_t nCoordinators = 0;
+  std::set<Name> discovered;
+  std::map<Name, std::map<uint64_t, RsuCoordinator::DiscoveryCallback>> subscriptions;
+  std::map<uint64_t, Name> subscriptionPrefixes;
+};
+
+std::map<uint32_t, Region> g_regions;
+uint64_t g_lastSubscriptionId = 0;
+
+} // namespace
+
+NS_OBJECT_ENSURE_REGISTERED(RsuCoordinator);
+
+TypeId
+RsuCoordinator::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RsuCoordinator")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<RsuCoordinator>()
+      .AddAttribute("Region", "Region of the RSU, RSUs of the same region share discoveries",
+                    UintegerValue(0), MakeUintegerAccessor(&RsuCoordinator::m_region),
+                    MakeUintegerChecker<uint32_t>());
+  return tid;
+}
+
+RsuCoordinator::RsuCoordinator()
+  : m_region(0)
+  , m_isJoined(false)
+{
+}
+
+void
+RsuCoordinator::Join()
+{
+  if (m_isJoined)
+    return;
+
+  g_regions[m_region].nCoordinators++;
+  m_isJoined = true;
+}
+
+uint32_t
+RsuCoordinator::GetRegion() const
+{
+  return m_region;
+}
+
+void
+RsuCoordinator::ReportDiscovery(const Name& name)
+{
+  Join();
+  Region& region = g_regions[m_region];
+
+  if (!region.discovered.insert(name).second)
+    return;
+
+  NS_LOG_DEBUG("Region " << m_region << ": " << name << " discovered");
+
+  // cost depends only on the name length, not on the number of regions or discovered names
+  std::vector<DiscoveryCallback> callbacks;
+  for (size_t prefixLength = 0; prefixLength <= name.size(); ++prefixLength) {
+    auto subscriptions = region.subscriptions.find(name.getPrefix(prefixLength));
+    if (subscriptions == region.subscriptions.end())
+      continue;
+
+    for (const auto& subscription : subscriptions->second) {
+      callbacks.push_back(subscription.second);
+    }
+  }
+
+  // callbacks are allowed to (un)subscribe
+  for (const auto& callback : callbacks) {
+    callback(name);
+  }
+}
+
+bool
+RsuCoordinator::IsDiscovered(const Name& prefix) const
+{
+  auto region = g_regions.find(m_region);
+  if (region == g_regions.end())
+    return false;
+
+  // names under the prefix directly follow it in the canonical order
+  auto name = region->second.discovered.lower_bound(prefix);
+  return name != region->second.discovered.end() && prefix.isPrefixOf(*name);
+}
+
+uint64_t
+RsuCoordinator::Subscribe(const Name& prefix, const DiscoveryCallback& callback)
+{
+  Join();
+  Region& region = g_regions[m_region];
+
+  uint64_t subscriptionId = ++g_lastSubscriptionId;
+  region.subscriptions[prefix][subscriptionId] = callback;
+  region.subscriptionPrefixes[subscriptionId] = prefix;
+  m_subscriptions.insert(subscriptionId);
+
+  std::vector<Name> discovered;
+  for (auto name = region.discovered.lower_bound(prefix);
+       name != region.discovered.end() && prefix.isPrefixOf(*name); ++name) {
+    discovered.push_back(*name);
+  }
+  for (const Name& name : discovered) {
+    callback(name);
+  }
+
+  return subscriptionId;
+}
+
+void
+RsuCoordinator::Unsubscribe(uint64_t subscriptionId)
+{
+  if (m_subscriptions.erase(subscriptionId) == 0)
+    return;
+
+  auto region = g_regions.find(m_region);
+  if (region == g_regions.end()) // cleared
+    return;
+
+  auto prefix = region->second.subscriptionPrefixes.find(subscriptionId);
+  if (prefix == region->second.subscriptionPrefixes.end())
+    return;
+
+  auto subscriptions = region->second.subscriptions.find(prefix->second);
+  subscriptions->second.erase(subscriptionId);
+  if (subscriptions->second.empty()) {
+    region->second.subscriptions.erase(subscriptions);
+  }
+  region->second.subscriptionPrefixes.erase(prefix);
+}
+
+void
+RsuCoordinator::clear()
+{
+  g_regions.clear();
+}
+
+void
+RsuCoordinator::DoDispose()
+{
+  while (!m_subscriptions.empty()) {
+    Unsubscribe(*m_subscriptions.begin());
+  }
+
+  if (m_isJoined) {
+    auto region = g_regions.find(m_region);
+    if (region != g_regions.end() && region->second.nCoordinators > 0
+        && --region->second.nCoordinators == 0) {
+      g_regions.erase(region);
+    }
+    m_isJoined = false;
+  }
+
+  Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RSU_COORDINATOR_H
+#define NDN_RSU_COORDINATOR_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+
+#include <functional>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Coordination of road side units (RSUs) over their backbone network
+ *
+ * The coordinator is aggregated on RSU nodes.  RSUs of the same region share which content has
+ * been discovered: once an RSU reports a discovered Data name, every RSU of the region subscribed
+ * to a prefix of the name is notified.  Discovery state is kept per region and per name, so any
+ * number of content items and regions can be coordinated concurrently.
+ *
+ * Region state is global for the simulation and is released when the last coordinator of the
+ * region is disposed (or with clear()).
+ */
+class RsuCoordinator : public Object {
+public:
+  typedef std::function<void(const Name& name)> DiscoveryCallback;
+
+  static TypeId
+  GetTypeId();
+
+  RsuCoordinator();
+
+  /**
+   * @brief Region of the RSU (set with the "Region" attribute before the first use)
+   */
+  uint32_t
+  GetRegion() const;
+
+  /**
+   * @brief Announce that content with the name has been discovered by the RSU
+   *
+   * Subscribers of the region to prefixes of the name are notified synchronously, unless the
+   * name has been already discovered in the region.
+   */
+  void
+  ReportDiscovery(const Name& name);
+
+  /**
+   * @brief Check whether any content under the prefix has been discovered in the region
+   */
+  bool
+  IsDiscovered(const Name& prefix) const;
+
+  /**
+   * @brief Subscribe to discoveries under the prefix in the region
+   *
+   * The callback is invoked right away for content under the prefix that has already been
+   * discovered.
+   *
+   * @return subscription ID to be used with Unsubscribe
+   */
+  uint64_t
+  Subscribe(const Name& prefix, const DiscoveryCallback& callback);
+
+  /**
+   * @brief Cancel subscription created by Subscribe
+   */
+  void
+  Unsubscribe(uint64_t subscriptionId);
+
+  /**
+   * @brief Clear discovery state and subscriptions of all regions
+   */
+  static void
+  clear();
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  /**
+   * @brief Count the coordinator in its region (on first use, after the attributes are set)
+   */
+  void
+  Join();
+
+private:
+  uint32_t m_region;
+  bool m_isJoined;
+  std::set<uint64_t> m_subscriptions; ///< @brief subscriptions made through this coordinator
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RSU_COORDINATOR_H
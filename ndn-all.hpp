@@ -34,9 +34,15 @@
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tables-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-filter.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-rsu-coordinator.hpp"
+#include "ns3/ndnSIM/model/ndn-content-trigger-engine.hpp"
 // #include "ns3/ndnSIM/model/ndn-net-device-face.hpp"
 
 // #include "ns3/ndnSIM/apps/ndn-app.hpp"
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-consumer-send-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Installs --consumers ConsumerCbr apps (one per node, each with its own NDN stack) and runs
+ * them for --sim-time.  Prints how many consumers are set up per second of wall-clock time and
+ * how many Interests per second they send:
+ *
+ *     ./waf --run "ndn-consumer-send-benchmark --consumers=10000"
+ *
+ * With --app=ns3::ndn::ConsumerZipfMandelbrot, Interests carry sequence numbers in the name.
+ */
+class Tester {
+public:
+  Tester()
+    : m_app("ns3::ndn::ConsumerCbr")
+    , m_nConsumers(10000)
+    , m_interestRate(100)
+    , m_simulationTime(Seconds(10))
+    , m_nInterests(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  onInterest(shared_ptr<const ndn::Interest>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+  {
+    m_nInterests++;
+  }
+
+  static double
+  now();
+
+private:
+  std::string m_app;
+  uint32_t m_nConsumers;
+  double m_interestRate;
+  Time m_simulationTime;
+  uint64_t m_nInterests;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("app", "Consumer application", m_app);
+  cmd.AddValue("consumers", "Number of consumers", m_nConsumers);
+  cmd.AddValue("rate", "Interest rate of every consumer", m_interestRate);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  double start = now();
+
+  NodeContainer nodes;
+  nodes.Create(m_nConsumers);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper(m_app);
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+  consumerHelper.Install(nodes);
+
+  double setup = now() - start;
+  std::cout << "Setup: " << m_nConsumers / setup << " consumers/s (" << setup << "s)"
+            << std::endl;
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::App/TransmittedInterests",
+                                MakeCallback(&Tester::onInterest, this));
+
+  Simulator::Stop(m_simulationTime);
+
+  start = now();
+  Simulator::Run();
+  double elapsed = now() - start;
+
+  std::cout << "Run: " << m_nInterests << " Interests, " << m_nInterests / elapsed
+            << " Interests/s (" << elapsed << "s)" << std::endl;
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
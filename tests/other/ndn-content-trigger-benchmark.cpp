@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-content-trigger-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-periodic-timer.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Places --vehicles nodes on a --road-length road, driving at 20-40 m/s, and --zones content
+ * triggers (100 m long, moving at 0-20 m/s) spread along the road.  Every vehicle watches every
+ * zone.  Prints the wall-clock time of the run and the number of enter/leave notifications:
+ *
+ *     ./waf --run "ndn-content-trigger-benchmark --vehicles=10000 --zones=10"
+ *
+ * With --naive=1, every vehicle checks every zone once per second, as the apps did before
+ * ContentTriggerEngine.
+ */
+class Tester {
+public:
+  Tester()
+    : m_nVehicles(10000)
+    , m_nZones(10)
+    , m_roadLength(100000)
+    , m_naive(false)
+    , m_simulationTime(Seconds(60))
+    , m_nNotifications(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  onZone(bool)
+  {
+    m_nNotifications++;
+  }
+
+  void
+  poll(Ptr<MobilityModel> mobility, std::vector<bool>* isInside);
+
+  static double
+  now();
+
+private:
+  uint32_t m_nVehicles;
+  uint32_t m_nZones;
+  double m_roadLength;
+  bool m_naive;
+  Time m_simulationTime;
+  uint64_t m_nNotifications;
+
+  std::vector<ndn::ContentTriggerEngine::Zone> m_zones;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::poll(Ptr<MobilityModel> mobility, std::vector<bool>* isInside)
+{
+  Vector position = mobility->GetPosition();
+  double elapsed = Simulator::Now().GetSeconds() - 1;
+  for (size_t i = 0; i < m_zones.size(); i++) {
+    const ndn::ContentTriggerEngine::Zone& zone = m_zones[i];
+    double dx = zone.xSpeed * elapsed;
+    bool inside = position.x >= zone.xMin + dx && position.x < zone.xMax + dx;
+    if (inside != (*isInside)[i]) {
+      (*isInside)[i] = inside;
+      onZone(inside);
+    }
+  }
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("vehicles", "Number of vehicles", m_nVehicles);
+  cmd.AddValue("zones", "Number of content triggers", m_nZones);
+  cmd.AddValue("road-length", "Length of the road (m)", m_roadLength);
+  cmd.AddValue("naive", "Check every zone from every vehicle once per second", m_naive);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+
+  NodeContainer nodes;
+  nodes.Create(m_nVehicles);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+  mobility.Install(nodes);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<ConstantVelocityMobilityModel> model = (*node)->GetObject<ConstantVelocityMobilityModel>();
+    model->SetPosition(Vector(rand->GetValue(0, m_roadLength), rand->GetInteger(0, 3) * 5, 0));
+    model->SetVelocity(Vector(rand->GetValue(20, 40), 0, 0));
+  }
+
+  for (uint32_t i = 0; i < m_nZones; i++) {
+    double xStart = m_roadLength * i / m_nZones;
+    m_zones.push_back(ndn::ContentTriggerEngine::MakeRoadZone(xStart, xStart + 100,
+                                                              rand->GetValue(0, 20), Seconds(0),
+                                                              Time::Max()));
+  }
+
+  double start = now();
+
+  std::vector<std::vector<bool>> isInside(m_nVehicles, std::vector<bool>(m_nZones, false));
+  std::vector<std::unique_ptr<ndn::PeriodicTimer>> timers;
+  if (m_naive) {
+    for (uint32_t i = 0; i < m_nVehicles; i++) {
+      timers.emplace_back(new ndn::PeriodicTimer(
+        std::bind(&Tester::poll, this, nodes.Get(i)->GetObject<MobilityModel>(), &isInside[i])));
+      timers.back()->Start(Seconds(1));
+    }
+  }
+  else {
+    Ptr<ndn::ContentTriggerEngine> engine = ndn::ContentTriggerEngine::Get();
+    for (const ndn::ContentTriggerEngine::Zone& zone : m_zones) {
+      uint32_t zoneId = engine->AddZone(zone);
+      for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+        engine->Watch(zoneId, *node, std::bind(&Tester::onZone, this, std::placeholders::_1));
+      }
+    }
+  }
+
+  double setup = now() - start;
+
+  Simulator::Stop(m_simulationTime);
+  start = now();
+  Simulator::Run();
+  double elapsed = now() - start;
+
+  std::cout << (m_naive ? "per-vehicle polling" : "content trigger engine") << "\n"
+            << "  setup: " << setup << "s\n"
+            << "  run: " << elapsed << "s\n"
+            << "  notifications: " << m_nNotifications << std::endl;
+
+  timers.clear();
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-sharded-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+#include <sys/time.h>
+#include <thread>
+
+namespace ns3 {
+
+/**
+ * Measures Add/Lookup throughput of the sharded content store when it is used concurrently
+ * from 1 to 16 threads (75% lookups, 25% additions):
+ *
+ *     ./waf --run "ndn-cs-sharded-benchmark --cs=ns3::ndn::cs::Sharded::Lru --shards=16"
+ *
+ * Running with --shards=1 gives the baseline of a single trie protected by one lock.
+ */
+class Tester {
+public:
+  Tester()
+    : m_contentStore("ns3::ndn::cs::Sharded::Lru")
+    , m_nShards(16)
+    , m_csSize(100000)
+    , m_nOperations(1000000)
+    , m_nNames(200000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  double
+  runThreads(Ptr<ndn::ContentStore> cs, size_t nThreads);
+
+  static double
+  now();
+
+private:
+  std::string m_contentStore;
+  uint32_t m_nShards;
+  uint32_t m_csSize;
+  uint32_t m_nOperations;
+  uint32_t m_nNames;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+double
+Tester::runThreads(Ptr<ndn::ContentStore> cs, size_t nThreads)
+{
+  ndn::ContentStore* store = PeekPointer(cs);
+
+  // pre-create packets, so that only content store operations are measured
+  std::vector<std::vector<shared_ptr<ndn::Data>>> data(nThreads);
+  std::vector<std::vector<shared_ptr<ndn::Interest>>> interests(nThreads);
+  for (size_t t = 0; t < nThreads; ++t) {
+    for (uint32_t i = 0; i < m_nNames / nThreads; ++i) {
+      ndn::Name name("/prefix-" + std::to_string(i % 1024));
+      name.append("thread-" + std::to_string(t)).appendSequenceNumber(i);
+      data[t].push_back(make_shared<ndn::Data>(name));
+      interests[t].push_back(make_shared<ndn::Interest>(name));
+    }
+  }
+
+  uint32_t nOperationsPerThread = m_nOperations / nThreads;
+  double begin = now();
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&, t] {
+        size_t nNames = data[t].size();
+        for (uint32_t i = 0; i < nOperationsPerThread; ++i) {
+          if (i % 4 == 0) {
+            store->Add(data[t][i % nNames]);
+          }
+          else {
+            store->Lookup(interests[t][(i * 7) % nNames]);
+          }
+        }
+      });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return now() - begin;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("cs", "Thread-safe content store to evaluate", m_contentStore);
+  cmd.AddValue("shards", "Number of shards (for sharded content stores)", m_nShards);
+  cmd.AddValue("cs-size", "Maximum number of cached packets", m_csSize);
+  cmd.AddValue("operations", "Total number of operations per run", m_nOperations);
+  cmd.AddValue("names", "Number of distinct names", m_nNames);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Threads"
+            << "\t"
+            << "RealTime"
+            << "\t"
+            << "Operations (per real time)"
+            << "\t"
+            << "Speedup"
+            << "\n";
+
+  double baseline = 0;
+  for (size_t nThreads : {1, 2, 4, 8, 16}) {
+    ObjectFactory factory;
+    factory.SetTypeId(m_contentStore);
+    factory.Set("MaxSize", UintegerValue(m_csSize));
+    if (m_contentStore.find("Sharded") != std::string::npos) {
+      factory.Set("Shards", UintegerValue(m_nShards));
+    }
+
+    double realTime = runThreads(factory.Create<ndn::ContentStore>(), nThreads);
+    double opsPerSec = m_nOperations / realTime;
+    if (baseline == 0) {
+      baseline = opsPerSec;
+    }
+
+    std::cout << nThreads << "\t" << realTime << "\t" << opsPerSec << "\t"
+              << opsPerSec / baseline << "\n";
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
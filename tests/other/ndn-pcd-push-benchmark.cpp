@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-pcd-push-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Places --vehicles nodes along a highway (--spacing meters apart) on an ad hoc 802.11a channel
+ * and lets every vehicle push proactive content (PCD) each --interval using
+ * L3Protocol::pushData, as ProactiveProducer does.  Prints how many pushes per second of
+ * wall-clock time the simulation sustains:
+ *
+ *     ./waf --run "ndn-pcd-push-benchmark --vehicles=1000"
+ */
+class Tester {
+public:
+  Tester()
+    : m_nVehicles(1000)
+    , m_spacing(10.0)
+    , m_payloadSize(1024)
+    , m_interval(Seconds(1))
+    , m_simulationTime(Seconds(10))
+    , m_nPushes(0)
+    , m_nReceived(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  push(Ptr<Node> node, uint32_t seq);
+
+  void
+  onData(const ndn::Data&, const ndn::Face&)
+  {
+    m_nReceived++;
+  }
+
+  static double
+  now();
+
+private:
+  uint32_t m_nVehicles;
+  double m_spacing;
+  uint32_t m_payloadSize;
+  Time m_interval;
+  Time m_simulationTime;
+  uint64_t m_nPushes;
+  uint64_t m_nReceived;
+  ndn::DataTemplate m_dataTemplate;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::push(Ptr<Node> node, uint32_t seq)
+{
+  auto data = m_dataTemplate.Make(ndn::Name("/pcd").append(std::to_string(node->GetId()))
+                                   .appendSequenceNumber(seq));
+
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol>();
+  l3->cacheData(*data);
+  m_nPushes += l3->pushData(*data);
+
+  Simulator::Schedule(m_interval, &Tester::push, this, node, seq + 1);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::WifiRemoteStationManager::NonUnicastMode",
+                     StringValue("OfdmRate24Mbps"));
+
+  CommandLine cmd;
+  cmd.AddValue("vehicles", "Number of vehicles", m_nVehicles);
+  cmd.AddValue("spacing", "Distance between vehicles (m)", m_spacing);
+  cmd.AddValue("payload", "Virtual payload size", m_payloadSize);
+  cmd.AddValue("interval", "Interval between pushes of every vehicle", m_interval);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  // pushed Data are made from a template, as in ProactiveProducer
+  ndn::Data prototype;
+  prototype.setContent(make_shared< ::ndn::Buffer>(m_payloadSize));
+  ndn::Signature signature;
+  signature.setInfo(ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  prototype.setSignature(signature);
+  m_dataTemplate = ndn::DataTemplate(prototype);
+
+  WifiHelper wifi;
+  wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode",
+                               StringValue("OfdmRate24Mbps"));
+
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss("ns3::RangePropagationLossModel", "MaxRange", DoubleValue(100));
+
+  YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default();
+  wifiPhyHelper.SetChannel(wifiChannel.Create());
+
+  WifiMacHelper wifiMacHelper;
+  wifiMacHelper.SetType("ns3::AdhocWifiMac");
+
+  NodeContainer nodes;
+  nodes.Create(m_nVehicles);
+  wifi.Install(wifiPhyHelper, wifiMacHelper, nodes);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator("ns3::GridPositionAllocator", "DeltaX", DoubleValue(m_spacing),
+                                "GridWidth", UintegerValue(m_nVehicles));
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  Config::ConnectWithoutContext("/NodeList/*/$ns3::ndn::L3Protocol/InData",
+                                MakeCallback(&Tester::onData, this));
+
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable>();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    Simulator::Schedule(Seconds(start->GetValue(0, m_interval.GetSeconds())), &Tester::push, this,
+                        *node, 0);
+  }
+
+  Simulator::Stop(m_simulationTime);
+
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  std::cout << "Pushes: " << m_nPushes << ", " << m_nPushes / elapsed << " pushes/s ("
+            << elapsed << "s)\n"
+            << "Received: " << m_nReceived << " Data" << std::endl;
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-retx-events-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Star topology with --consumers low-rate consumers around one producer.  Prints the number of
+ * executed simulator events and the wall-clock time, to compare event-per-deadline
+ * retransmission scheduling with polling every RetxTimer:
+ *
+ *     ./waf --run "ndn-retx-events-benchmark --consumers=1000"
+ *     ./waf --run "ndn-retx-events-benchmark --consumers=1000 --polling=1"
+ */
+class Tester {
+public:
+  Tester()
+    : m_nConsumers(1000)
+    , m_interestRate(1)
+    , m_polling(false)
+    , m_simulationTime(Seconds(100))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_nConsumers;
+  double m_interestRate;
+  bool m_polling;
+  Time m_simulationTime;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("100Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  CommandLine cmd;
+  cmd.AddValue("consumers", "Number of consumer nodes", m_nConsumers);
+  cmd.AddValue("rate", "Interest rate of every consumer", m_interestRate);
+  cmd.AddValue("polling", "Check retransmission timeouts every RetxTimer", m_polling);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer producer;
+  producer.Create(1);
+  NodeContainer consumers;
+  consumers.Create(m_nConsumers);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < m_nConsumers; i++) {
+    p2p.Install(consumers.Get(i), producer.Get(0));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  for (uint32_t i = 0; i < m_nConsumers; i++) {
+    ndn::FibHelper::AddRoute(consumers.Get(i), "/prefix", producer.Get(0), 10);
+  }
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+  consumerHelper.SetAttribute("RetxPolling", BooleanValue(m_polling));
+  consumerHelper.Install(consumers);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  Simulator::Stop(m_simulationTime);
+
+  double start = now();
+  Simulator::Run();
+  double elapsed = now() - start;
+
+  std::cout << (m_polling ? "polling" : "per-deadline") << " retransmission checks\n"
+            << "  events executed: " << Simulator::GetEventCount() << "\n"
+            << "  wall-clock time: " << elapsed << "s" << std::endl;
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-rtt-estimator-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Drives an RTT estimator the way ndn::Consumer does, for a long simulated period (one hour
+ * by default): Interests are sent at --rate, Data returns after a uniformly random delay (so
+ * out of order) or is lost with --loss probability, in which case the Interest times out after
+ * one second and is sent again.  Memory usage, wall-clock time and the RTO are printed every
+ * simulated minute:
+ *
+ *     ./waf --run "ndn-rtt-estimator-benchmark --estimator=ns3::ndn::RttSeqMeanDeviation"
+ *     ./waf --run "ndn-rtt-estimator-benchmark --estimator=ns3::ndn::RttMeanDeviation"
+ */
+class Tester {
+public:
+  Tester()
+    : m_estimator("ns3::ndn::RttSeqMeanDeviation")
+    , m_rate(1000)
+    , m_loss(0.01)
+    , m_simulationTime(Seconds(3600))
+    , m_seq(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  send(uint32_t seq);
+
+  void
+  sendNext();
+
+  void
+  ack(uint32_t seq);
+
+  void
+  timeout(uint32_t seq);
+
+  void
+  printStats(double beginRealTime);
+
+  static double
+  now();
+
+private:
+  std::string m_estimator;
+  double m_rate;
+  double m_loss;
+  Time m_simulationTime;
+
+  Ptr<ndn::RttEstimator> m_rtt;
+  Ptr<UniformRandomVariable> m_rand;
+  uint32_t m_seq;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+void
+Tester::send(uint32_t seq)
+{
+  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+
+  if (m_rand->GetValue() < m_loss) {
+    Simulator::Schedule(Seconds(1), &Tester::timeout, this, seq);
+  }
+  else {
+    Simulator::Schedule(MilliSeconds(m_rand->GetInteger(10, 200)), &Tester::ack, this, seq);
+  }
+}
+
+void
+Tester::sendNext()
+{
+  send(m_seq++);
+  Simulator::Schedule(Seconds(1.0 / m_rate), &Tester::sendNext, this);
+}
+
+void
+Tester::ack(uint32_t seq)
+{
+  m_rtt->AckSeq(SequenceNumber32(seq));
+}
+
+void
+Tester::timeout(uint32_t seq)
+{
+  m_rtt->IncreaseMultiplier();
+  m_rtt->TimeoutSeq(SequenceNumber32(seq));
+  send(seq);
+}
+
+void
+Tester::printStats(double beginRealTime)
+{
+  std::cout << Simulator::Now().ToDouble(Time::S) << "\t" << now() - beginRealTime << "\t"
+            << m_seq << "\t" << m_rtt->RetransmitTimeout().ToDouble(Time::S) << "\t"
+            << MemUsage::Get() / 1024.0 / 1024.0 << "\n";
+
+  Simulator::Schedule(Seconds(60), &Tester::printStats, this, beginRealTime);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("estimator", "RTT estimator to use", m_estimator);
+  cmd.AddValue("rate", "Interest rate", m_rate);
+  cmd.AddValue("loss", "Probability that Data does not come back", m_loss);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  ObjectFactory factory(m_estimator);
+  m_rtt = factory.Create<ndn::RttEstimator>();
+  m_rand = CreateObject<UniformRandomVariable>();
+
+  std::cout << "SimulationTime"
+            << "\t"
+            << "RealTime"
+            << "\t"
+            << "NumberOfInterests"
+            << "\t"
+            << "RTO"
+            << "\t"
+            << "MemUsage(MiB)"
+            << "\n";
+
+  Simulator::Schedule(Seconds(0), &Tester::sendNext, this);
+  Simulator::Schedule(Seconds(0), &Tester::printStats, this, now());
+  Simulator::Stop(m_simulationTime);
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
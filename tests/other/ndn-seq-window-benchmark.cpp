@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-seq-window-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-seq-window.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/tag.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <sys/time.h>
+#include <iostream>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * Compares per-Interest bookkeeping of ndn::Consumer: the former three multi_index containers
+ * plus the retx count map against ndn::SeqWindow.  The consumer keeps --outstanding Interests
+ * in flight; for each of --operations steps the oldest one is satisfied, a new one is sent and
+ * expired retransmission timers are checked:
+ *
+ *     ./waf --run "ndn-seq-window-benchmark --outstanding=100000"
+ */
+class Tester {
+public:
+  Tester()
+    : m_nOutstanding(100000)
+    , m_nOperations(10000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  double
+  runMultiIndex();
+
+  double
+  runSeqWindow();
+
+  static double
+  now();
+
+private:
+  uint32_t m_nOutstanding;
+  uint32_t m_nOperations;
+};
+
+struct SeqTimeout {
+  SeqTimeout(uint32_t _seq, Time _time)
+    : seq(_seq)
+    , time(_time)
+  {
+  }
+
+  uint32_t seq;
+  Time time;
+};
+
+class i_seq {
+};
+class i_timestamp {
+};
+
+typedef boost::multi_index::
+  multi_index_container<SeqTimeout,
+                        boost::multi_index::
+                          indexed_by<boost::multi_index::
+                                       ordered_unique<boost::multi_index::tag<i_seq>,
+                                                      boost::multi_index::
+                                                        member<SeqTimeout, uint32_t,
+                                                               &SeqTimeout::seq>>,
+                                     boost::multi_index::
+                                       ordered_non_unique<boost::multi_index::tag<i_timestamp>,
+                                                          boost::multi_index::
+                                                            member<SeqTimeout, Time,
+                                                                   &SeqTimeout::time>>>>
+    SeqTimeoutsContainer;
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+double
+Tester::runMultiIndex()
+{
+  SeqTimeoutsContainer seqTimeouts;
+  SeqTimeoutsContainer seqLastDelay;
+  SeqTimeoutsContainer seqFullDelay;
+  std::map<uint32_t, uint32_t> seqRetxCounts;
+  Time rto = Seconds(1000);
+  uint64_t checksum = 0;
+
+  auto send = [&] (uint32_t seq, Time time) {
+    seqTimeouts.insert(SeqTimeout(seq, time));
+    seqFullDelay.insert(SeqTimeout(seq, time));
+    seqLastDelay.erase(seq);
+    seqLastDelay.insert(SeqTimeout(seq, time));
+    seqRetxCounts[seq]++;
+  };
+
+  for (uint32_t seq = 0; seq < m_nOutstanding; seq++) {
+    send(seq, MicroSeconds(seq));
+  }
+
+  double start = now();
+  for (uint32_t i = 0; i < m_nOperations; i++) {
+    uint32_t seq = i;
+    Time time = MicroSeconds(m_nOutstanding + i);
+
+    SeqTimeoutsContainer::iterator entry = seqFullDelay.find(seq);
+    if (entry != seqFullDelay.end()) {
+      checksum += (time - entry->time).GetMicroSeconds() + seqRetxCounts[seq];
+    }
+    seqRetxCounts.erase(seq);
+    seqFullDelay.erase(seq);
+    seqLastDelay.erase(seq);
+    seqTimeouts.erase(seq);
+
+    send(m_nOutstanding + i, time);
+
+    while (!seqTimeouts.empty()) {
+      auto timeout = seqTimeouts.get<i_timestamp>().begin();
+      if (timeout->time + rto > time)
+        break;
+      seqTimeouts.get<i_timestamp>().erase(timeout);
+    }
+  }
+  double elapsed = now() - start;
+
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+  return elapsed;
+}
+
+double
+Tester::runSeqWindow()
+{
+  ndn::SeqWindow window;
+  Time rto = Seconds(1000);
+  uint64_t checksum = 0;
+
+  for (uint32_t seq = 0; seq < m_nOutstanding; seq++) {
+    window.Sent(seq, MicroSeconds(seq));
+  }
+
+  double start = now();
+  for (uint32_t i = 0; i < m_nOperations; i++) {
+    uint32_t seq = i;
+    Time time = MicroSeconds(m_nOutstanding + i);
+
+    ndn::SeqWindow::Entry* entry = window.Find(seq);
+    if (entry != nullptr) {
+      checksum += (time - entry->firstSent).GetMicroSeconds() + entry->retxCount;
+    }
+    window.Erase(seq);
+
+    window.Sent(m_nOutstanding + i, time);
+
+    window.ExpireTimeouts(rto, time, [] (uint32_t) {});
+  }
+  double elapsed = now() - start;
+
+  std::cout << "  (checksum " << checksum << ", ring capacity " << window.GetCapacity() << ")"
+            << std::endl;
+  return elapsed;
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("outstanding", "Number of outstanding Interests", m_nOutstanding);
+  cmd.AddValue("operations", "Number of Data/Interest steps", m_nOperations);
+  cmd.Parse(argc, argv);
+
+  std::cout << "multi_index containers:" << std::endl;
+  double multiIndex = runMultiIndex();
+  std::cout << "  " << m_nOperations / multiIndex << " steps/s" << std::endl;
+
+  std::cout << "SeqWindow:" << std::endl;
+  double seqWindow = runSeqWindow();
+  std::cout << "  " << m_nOperations / seqWindow << " steps/s" << std::endl;
+
+  std::cout << "speedup: " << multiIndex / seqWindow << "x" << std::endl;
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
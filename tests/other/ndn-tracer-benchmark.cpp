@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-tracer-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/filesystem.hpp>
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Installs a ConsumerCbr on each of --nodes nodes and traces them with L3RateTracer,
+ * CsTracer and AppDelayTracer every --period.  Prints the wall-clock time of the run and the
+ * size of the traces:
+ *
+ *     ./waf --run "ndn-tracer-benchmark --nodes=1000 --format=bin"
+ *
+ * With --format=txt, the traces are written as tab-separated text.  With --async=0, the traces
+ * are written from the simulation thread instead of a background writer thread.  With
+ * --aggregate=1, L3RateTracer writes only the sum and percentiles across the nodes.  With
+ * --histograms=1, AppDelayTracer writes delay distributions every --period instead of a record
+ * for every Data.
+ */
+class Tester {
+public:
+  Tester()
+    : m_nNodes(1000)
+    , m_format("bin")
+    , m_isAsync(true)
+    , m_isAggregated(false)
+    , m_isHistograms(false)
+    , m_period(Seconds(0.1))
+    , m_simulationTime(Seconds(60))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_nNodes;
+  std::string m_format;
+  bool m_isAsync;
+  bool m_isAggregated;
+  bool m_isHistograms;
+  Time m_period;
+  Time m_simulationTime;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", m_nNodes);
+  cmd.AddValue("format", "Trace format: bin or txt", m_format);
+  cmd.AddValue("async", "Write traces in a background thread", m_isAsync);
+  cmd.AddValue("aggregate", "Aggregate L3 rates across the nodes", m_isAggregated);
+  cmd.AddValue("histograms", "Write app delay distributions", m_isHistograms);
+  cmd.AddValue("period", "Tracing period", m_period);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(m_nNodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(10));
+  consumerHelper.Install(nodes);
+
+  std::vector<std::string> files = {"rate-trace." + m_format, "cs-trace." + m_format,
+                                    "app-delays-trace." + m_format};
+  ndn::TraceSink::SetAsyncWriting(m_isAsync);
+  if (m_isAggregated) {
+    ndn::L3RateTracer::InstallAggregated(nodes, files[0], m_period);
+  }
+  else {
+    ndn::L3RateTracer::InstallAll(files[0], m_period);
+  }
+  ndn::CsTracer::InstallAll(files[1], m_period);
+  if (m_isHistograms) {
+    ndn::AppDelayTracer::InstallAllHistograms(files[2], m_period);
+  }
+  else {
+    ndn::AppDelayTracer::InstallAll(files[2]);
+  }
+
+  Simulator::Stop(m_simulationTime);
+
+  double start = now();
+  Simulator::Run();
+  ndn::L3RateTracer::Destroy();
+  ndn::CsTracer::Destroy();
+  ndn::AppDelayTracer::Destroy();
+  double elapsed = now() - start;
+
+  uintmax_t size = 0;
+  for (const std::string& file : files) {
+    size += boost::filesystem::file_size(file);
+    boost::filesystem::remove(file);
+  }
+
+  std::cout << m_format << (m_isAsync ? " traces, background writer\n" : " traces\n")
+            << "  run: " << elapsed << "s\n"
+            << "  size: " << size / 1024 << " KiB" << std::endl;
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-utility-timer-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/map-scheduler.h"
+#include "ns3/ndnSIM/utils/ndn-periodic-timer.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * @brief Map scheduler that keeps track of the number of pending events
+ */
+class CountingScheduler : public MapScheduler {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CountingScheduler")
+                          .SetParent<MapScheduler>()
+                          .SetGroupName("Ndn")
+                          .AddConstructor<CountingScheduler>();
+    return tid;
+  }
+
+  virtual void
+  Insert(const Event& ev)
+  {
+    MapScheduler::Insert(ev);
+    if (++s_size > s_peak)
+      s_peak = s_size;
+  }
+
+  virtual Event
+  RemoveNext()
+  {
+    --s_size;
+    return MapScheduler::RemoveNext();
+  }
+
+  virtual void
+  Remove(const Event& ev)
+  {
+    --s_size;
+    MapScheduler::Remove(ev);
+  }
+
+public:
+  static uint64_t s_size;
+  static uint64_t s_peak;
+};
+
+uint64_t CountingScheduler::s_size = 0;
+uint64_t CountingScheduler::s_peak = 0;
+
+/**
+ * Installs a Producer on each of --vehicles nodes, runs a one-second utility loop per vehicle for
+ * --sim-end seconds, and prints the peak number of pending simulator events together with the
+ * wall-clock time to start the apps:
+ *
+ *     ./waf --run "ndn-utility-timer-benchmark --vehicles=10000 --sim-end=3600"
+ *
+ * By default, each loop is a PeriodicTimer (as used by ContentTriggerEngine for its ticks).
+ * With --legacy=1, the loop events are pre-scheduled for the whole run, one per second and
+ * vehicle, as the apps did before PeriodicTimer.
+ */
+class Tester {
+public:
+  Tester()
+    : m_nVehicles(10000)
+    , m_simEnd(3600)
+    , m_legacy(false)
+    , m_simulationTime(Seconds(10))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static void
+  noop()
+  {
+  }
+
+  static double
+  now();
+
+private:
+  uint32_t m_nVehicles;
+  uint32_t m_simEnd;
+  bool m_legacy;
+  Time m_simulationTime;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("vehicles", "Number of vehicles", m_nVehicles);
+  cmd.AddValue("sim-end", "SimEnd of the apps (seconds)", m_simEnd);
+  cmd.AddValue("legacy", "Pre-schedule one utility event per second and vehicle", m_legacy);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  ObjectFactory scheduler;
+  scheduler.SetTypeId(CountingScheduler::GetTypeId());
+  Simulator::SetScheduler(scheduler);
+
+  NodeContainer nodes;
+  nodes.Create(m_nVehicles);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("SimEnd", UintegerValue(m_simEnd));
+  producerHelper.Install(nodes);
+
+  std::vector<std::unique_ptr<ndn::PeriodicTimer>> timers;
+  double start = now();
+  for (uint32_t node = 0; node < m_nVehicles; node++) {
+    if (m_legacy) {
+      for (uint32_t i = 1; i < m_simEnd; i++) {
+        Simulator::Schedule(Seconds(i), &Tester::noop);
+      }
+    }
+    else {
+      timers.emplace_back(new ndn::PeriodicTimer(&Tester::noop));
+      timers.back()->Start(Seconds(1), Seconds(m_simEnd));
+    }
+  }
+
+  // apps start at 0s
+  Simulator::Stop(MilliSeconds(500));
+  Simulator::Run();
+  double startup = now() - start;
+
+  std::cout << (m_legacy ? "pre-scheduled" : "periodic timer") << " utility loop\n"
+            << "  startup: " << startup << "s\n"
+            << "  peak pending events: " << CountingScheduler::s_peak << std::endl;
+
+  Simulator::Stop(m_simulationTime - MilliSeconds(500));
+  start = now();
+  Simulator::Run();
+  std::cout << "  run: " << now() - start << "s" << std::endl;
+
+  timers.clear();
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
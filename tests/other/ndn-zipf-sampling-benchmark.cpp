@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-zipf-sampling-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures ConsumerZipfMandelbrot::GetNextSeq throughput for a catalog of --contents objects,
+ * together with the time to set up --consumers consumers with identical parameters (the
+ * cumulative probability table is computed once and shared):
+ *
+ *     ./waf --run "ndn-zipf-sampling-benchmark --contents=10000000"
+ *
+ * With --linear=1, the former linear scan over the same table is measured as well.  With
+ * --file=<path>, the table is precomputed into the file and consumers memory-map it.
+ */
+class Tester {
+public:
+  Tester()
+    : m_nContents(1000000)
+    , m_nConsumers(100)
+    , m_nSamples(1000000)
+    , m_linear(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_nContents;
+  uint32_t m_nConsumers;
+  uint32_t m_nSamples;
+  bool m_linear;
+  std::string m_file;
+};
+
+double
+Tester::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("contents", "Number of contents in the catalog", m_nContents);
+  cmd.AddValue("consumers", "Number of consumers with identical parameters", m_nConsumers);
+  cmd.AddValue("samples", "Number of sampled sequence numbers", m_nSamples);
+  cmd.AddValue("linear", "Also measure the linear scan", m_linear);
+  cmd.AddValue("file", "Precompute popularity table into the file and map it", m_file);
+  cmd.Parse(argc, argv);
+
+  if (!m_file.empty()) {
+    ndn::PopularityTable::Save(m_file, m_nContents, 0.7, 0.7);
+  }
+
+  double memBefore = MemUsage::Get() / 1024.0 / 1024.0;
+  double start = now();
+
+  std::vector<Ptr<ndn::ConsumerZipfMandelbrot>> consumers;
+  for (uint32_t i = 0; i < m_nConsumers; i++) {
+    Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot>();
+    consumer->SetAttribute("NumberOfContents", UintegerValue(m_nContents));
+    consumer->SetAttribute("PopularityFile", StringValue(m_file));
+    consumer->GetNextSeq(); // the table is obtained on first use (or at start)
+    consumers.push_back(consumer);
+  }
+
+  std::cout << "Setup of " << m_nConsumers << " consumers: " << now() - start << "s, "
+            << MemUsage::Get() / 1024.0 / 1024.0 - memBefore << "MiB" << std::endl;
+
+  uint64_t checksum = 0;
+  start = now();
+  for (uint32_t i = 0; i < m_nSamples; i++) {
+    checksum += consumers[i % consumers.size()]->GetNextSeq();
+  }
+  double elapsed = now() - start;
+  std::cout << "Binary search: " << m_nSamples / elapsed << " samples/s (checksum " << checksum
+            << ")" << std::endl;
+
+  if (m_linear) {
+    std::vector<double> pcum(m_nContents + 1);
+    for (uint32_t i = 1; i <= m_nContents; i++) {
+      pcum[i] = pcum[i - 1] + 1.0 / std::pow(i + 0.7, 0.7);
+    }
+    for (uint32_t i = 1; i <= m_nContents; i++) {
+      pcum[i] = pcum[i] / pcum[m_nContents];
+    }
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    uint32_t nSamples = std::max<uint32_t>(1, m_nSamples / 1000);
+    checksum = 0;
+    start = now();
+    for (uint32_t i = 0; i < nSamples; i++) {
+      double p_random = rng->GetValue();
+      for (uint32_t j = 1; j <= m_nContents; j++) {
+        if (p_random <= pcum[j]) {
+          checksum += j;
+          break;
+        }
+      }
+    }
+    elapsed = now() - start;
+    std::cout << "Linear scan:   " << nSamples / elapsed << " samples/s (checksum " << checksum
+              << ")" << std::endl;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
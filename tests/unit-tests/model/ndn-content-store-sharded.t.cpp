@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/content-store-sharded.hpp"
+
+#include "../tests-common.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnContentStoreSharded, CleanupFixture)
+
+static Ptr<ContentStore>
+createShardedCs(const std::string& maxSize, const std::string& nShards)
+{
+  ObjectFactory factory;
+  factory.SetTypeId("ns3::ndn::cs::Sharded::Lru");
+  factory.Set("MaxSize", StringValue(maxSize));
+  factory.Set("Shards", StringValue(nShards));
+  return factory.Create<ContentStore>();
+}
+
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  data->setContent(make_shared< ::ndn::Buffer>(16));
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(AddLookupEnumerate)
+{
+  Ptr<ContentStore> cs = createShardedCs("0", "4");
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(cs->Add(makeData(Name("/prefix-" + std::to_string(i)).appendSequenceNumber(i))));
+  }
+  BOOST_CHECK(!cs->Add(makeData(Name("/prefix-0").appendSequenceNumber(0))));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 10);
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix-3")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix-11")) == nullptr);
+  // too short for the shard key, all shards are checked
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/")) != nullptr);
+
+  size_t nEntries = 0;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 10);
+}
+
+BOOST_AUTO_TEST_CASE(ApproximateSizeLimit)
+{
+  Ptr<ContentStore> cs = createShardedCs("100", "8");
+
+  for (int i = 0; i < 1000; ++i) {
+    cs->Add(makeData(Name("/prefix-" + std::to_string(i))));
+  }
+
+  // each of 8 shards holds at most ceil(100 / 8) = 13 entries
+  BOOST_CHECK_LE(cs->GetSize(), 104);
+  BOOST_CHECK_GE(cs->GetSize(), 80);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentStress)
+{
+  const int nThreads = 8;
+  const int nOperations = 20000;
+
+  Ptr<ContentStore> cs = createShardedCs("1000", "16");
+  ContentStore* store = PeekPointer(cs); // ns-3 reference counting is not thread-safe
+  std::atomic<int> nHits(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([store, t, &nHits] {
+        for (int i = 0; i < nOperations; ++i) {
+          Name name("/thread-" + std::to_string(t) + "-" + std::to_string(i % 64));
+          name.appendSequenceNumber(i % 512);
+
+          if (i % 3 == 0) {
+            store->Add(makeData(name));
+          }
+          else if (store->Lookup(make_shared<Interest>(name)) != nullptr) {
+            ++nHits;
+          }
+        }
+      });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_GT(nHits, 0);
+  BOOST_CHECK_LE(cs->GetSize(), 1008); // 16 shards of 63 entries
+
+  size_t nEntries = 0;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>(it->GetName())) != nullptr);
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, cs->GetSize());
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentInsertEvictSameNames)
+{
+  const int nThreads = 8;
+  const int nOperations = 20000;
+
+  // all threads add the same names to a store much smaller than the name set, so entries are
+  // concurrently created, rejected as duplicates, and evicted
+  Ptr<ContentStore> cs = createShardedCs("8", "2");
+  ContentStore* store = PeekPointer(cs);
+  std::atomic<int> nAdded(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([store, t, &nAdded] {
+        for (int i = 0; i < nOperations; ++i) {
+          Name name("/shared-" + std::to_string((i + t) % 4));
+          name.appendSequenceNumber((i * 7 + t) % 32);
+          if (store->Add(makeData(name))) {
+            ++nAdded;
+          }
+        }
+      });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_GT(nAdded, 0);
+  BOOST_CHECK_LE(cs->GetSize(), 8);
+
+  size_t nEntries = 0;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    BOOST_CHECK_EQUAL(it->GetReferenceCount(), 2); // trie and the iterator
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, cs->GetSize());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
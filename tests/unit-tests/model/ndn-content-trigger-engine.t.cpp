@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-content-trigger-engine.hpp"
+
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/constant-velocity-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnContentTriggerEngine, CleanupFixture)
+
+static Ptr<Node>
+makeNode(const Vector& position, const Vector& velocity)
+{
+  Ptr<Node> node = CreateObject<Node>();
+  Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel>();
+  mobility->SetPosition(position);
+  mobility->SetVelocity(velocity);
+  node->AggregateObject(mobility);
+  return node;
+}
+
+BOOST_AUTO_TEST_CASE(EnterLeave)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  uint32_t zoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(100, 200, 0, Seconds(0), Seconds(100)));
+
+  // crosses [100, 200) between 9s and 19s
+  Ptr<Node> node = makeNode(Vector(10, 0, 0), Vector(10, 0, 0));
+  std::vector<std::pair<Time, bool>> events;
+  engine->Watch(zoneId, node, [&events] (bool isInside) {
+      events.push_back(std::make_pair(Simulator::Now(), isInside));
+    });
+
+  Simulator::Stop(Seconds(30));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 2U);
+  BOOST_CHECK_EQUAL(events[0].first, Seconds(9));
+  BOOST_CHECK(events[0].second);
+  BOOST_CHECK_EQUAL(events[1].first, Seconds(19));
+  BOOST_CHECK(!events[1].second);
+  BOOST_CHECK_EQUAL(engine->GetMemberCount(zoneId), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(MovingZone)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  // evaluated before moving: [0, 10) at 1s, [10, 20) at 2s, ...
+  uint32_t zoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 10, 10, Seconds(0), Seconds(100)));
+  BOOST_CHECK_EQUAL(engine->GetZoneCenter(zoneId).x, 5);
+
+  Ptr<Node> node = makeNode(Vector(55, 1000, 0), Vector(0, 0, 0));
+  std::vector<std::pair<Time, bool>> events;
+  engine->Watch(zoneId, node, [&events] (bool isInside) {
+      events.push_back(std::make_pair(Simulator::Now(), isInside));
+    });
+
+  Simulator::Stop(Seconds(10.5));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 2U);
+  BOOST_CHECK_EQUAL(events[0].first, Seconds(6));
+  BOOST_CHECK(events[0].second);
+  BOOST_CHECK_EQUAL(events[1].first, Seconds(7));
+  BOOST_CHECK(!events[1].second);
+
+  // moved at each of the 10 ticks
+  BOOST_CHECK_EQUAL(engine->GetZoneCenter(zoneId).x, 105);
+}
+
+BOOST_AUTO_TEST_CASE(Lifetime)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  uint32_t zoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 0, Seconds(5), Seconds(8)));
+
+  Ptr<Node> node = makeNode(Vector(50, 0, 0), Vector(0, 0, 0));
+  std::vector<std::pair<Time, bool>> events;
+  engine->Watch(zoneId, node, [&events] (bool isInside) {
+      events.push_back(std::make_pair(Simulator::Now(), isInside));
+    });
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 2U);
+  BOOST_CHECK_EQUAL(events[0].first, Seconds(5));
+  BOOST_CHECK(events[0].second);
+  BOOST_CHECK_EQUAL(events[1].first, Seconds(8));
+  BOOST_CHECK(!events[1].second);
+}
+
+BOOST_AUTO_TEST_CASE(CourseChange)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  uint32_t zoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 0, Seconds(0), Seconds(100)));
+
+  Ptr<Node> node = makeNode(Vector(-1000, 0, 0), Vector(0, 0, 0));
+  std::vector<std::pair<Time, bool>> events;
+  uint64_t watchId = engine->Watch(zoneId, node, [&events] (bool isInside) {
+      events.push_back(std::make_pair(Simulator::Now(), isInside));
+    });
+
+  // teleported into the zone; cell of a still node is kept until its course changes
+  Simulator::Schedule(Seconds(3.5), [node] {
+      node->GetObject<MobilityModel>()->SetPosition(Vector(50, 0, 0));
+    });
+  Simulator::Schedule(Seconds(10.5), [engine, watchId] { engine->Unwatch(watchId); });
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(events.size(), 1U);
+  BOOST_CHECK_EQUAL(events[0].first, Seconds(4));
+  BOOST_CHECK(events[0].second);
+  BOOST_CHECK_EQUAL(engine->GetMemberCount(zoneId), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(SharedZones)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  uint32_t zoneId =
+    engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 10, Seconds(0), Seconds(10)));
+  BOOST_CHECK_EQUAL(engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 10, Seconds(0),
+                                                                       Seconds(10))),
+                    zoneId);
+  BOOST_CHECK_NE(engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 10, Seconds(0),
+                                                                    Seconds(20))),
+                 zoneId);
+  BOOST_CHECK_NE(engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 100, 10, Seconds(0),
+                                                                    Seconds(10), Seconds(2))),
+                 zoneId);
+}
+
+BOOST_AUTO_TEST_CASE(StaggeredStarts)
+{
+  Ptr<ContentTriggerEngine> engine = ContentTriggerEngine::Get();
+  Ptr<Node> node = makeNode(Vector(25, 0, 0), Vector(0, 0, 0));
+
+  // same CTx configured on apps started at 0s and 3.5s: each moves from its own start time
+  std::map<uint32_t, std::vector<std::pair<Time, bool>>> events;
+  auto start = [engine, node, &events] {
+    uint32_t zoneId =
+      engine->AddZone(ContentTriggerEngine::MakeRoadZone(0, 10, 10, Seconds(0), Seconds(100),
+                                                         Simulator::Now()));
+    BOOST_CHECK_EQUAL(engine->GetZoneCenter(zoneId).x, 5);
+    engine->Watch(zoneId, node, [zoneId, &events] (bool isInside) {
+        events[zoneId].push_back(std::make_pair(Simulator::Now(), isInside));
+      });
+    return zoneId;
+  };
+
+  uint32_t first = start();
+  uint32_t second = 0;
+  Simulator::Schedule(Seconds(3.5), [&] {
+      second = start();
+      BOOST_CHECK_NE(second, first);
+      BOOST_CHECK_EQUAL(engine->GetZoneCenter(first).x, 35);
+    });
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  // [20, 30) is evaluated at the third tick of each zone
+  BOOST_REQUIRE_EQUAL(events[first].size(), 2U);
+  BOOST_CHECK_EQUAL(events[first][0].first, Seconds(3));
+  BOOST_CHECK_EQUAL(events[first][1].first, Seconds(4));
+  BOOST_REQUIRE_EQUAL(events[second].size(), 2U);
+  BOOST_CHECK_EQUAL(events[second][0].first, Seconds(6.5));
+  BOOST_CHECK(events[second][0].second);
+  BOOST_CHECK_EQUAL(events[second][1].first, Seconds(7.5));
+  BOOST_CHECK(!events[second][1].second);
+
+  BOOST_CHECK_EQUAL(engine->GetZoneCenter(first).x, 105);
+  BOOST_CHECK_EQUAL(engine->GetZoneCenter(second).x, 65);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
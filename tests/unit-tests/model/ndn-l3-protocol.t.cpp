@@ -19,6 +19,7 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
 
 #include <ndn-cxx/face.hpp>
 
@@ -124,6 +125,62 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  Signature signature;
+  signature.setInfo(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+  data->wireEncode();
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(ContentArrivalWatch)
+{
+  createTopology({
+      {"1"},
+    });
+
+  Ptr<L3Protocol> l3 = getNode("1")->GetObject<L3Protocol>();
+
+  std::vector<Name> arrived;
+  uint64_t watchId = l3->watchPrefix("/criticalData", [&arrived] (const Data& data) {
+      arrived.push_back(data.getName());
+    });
+
+  l3->cacheData(*makeData("/criticalData/test"));
+  l3->cacheData(*makeData("/other/test"));
+  BOOST_REQUIRE_EQUAL(arrived.size(), 1);
+  BOOST_CHECK_EQUAL(arrived[0], Name("/criticalData/test"));
+
+  l3->unwatchPrefix(watchId);
+  l3->cacheData(*makeData("/criticalData/test2"));
+  BOOST_CHECK_EQUAL(arrived.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(PushData)
+{
+  createTopology({
+      {"1", "2"},
+      {"1", "3"},
+    });
+
+  Ptr<L3Protocol> l3 = getNode("1")->GetObject<L3Protocol>();
+  shared_ptr<Face> face = getFace("1", "2");
+
+  auto data = makeData("/criticalData/test");
+
+  // all faces backed by NetDevices
+  BOOST_CHECK_EQUAL(l3->pushData(*data), 2U);
+
+  // internal face is local, face 100000 does not exist
+  BOOST_CHECK_EQUAL(l3->pushData(*data, {face->getId(), ::nfd::face::FACEID_INTERNAL_FACE, 100000}),
+                    1U);
+  BOOST_CHECK_EQUAL(face->getCounters().nOutData, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
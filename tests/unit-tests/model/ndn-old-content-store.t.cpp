@@ -67,6 +67,36 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(PrefixRangeQueries)
+{
+  ObjectFactory factory;
+  factory.SetTypeId("ns3::ndn::cs::Lru");
+  factory.Set("MaxSize", StringValue("0"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  for (const std::string& name : {"/a", "/a/b/1", "/a/b/2", "/a/c", "/d/e"}) {
+    cs->Add(make_shared<Data>(name));
+  }
+
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/"), 5);
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/a"), 4);
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/a/b"), 2);
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/a/b/1"), 1);
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/a/x"), 0);
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/d/e/f"), 0);
+
+  std::set<Name> names;
+  cs->ForEachUnderPrefix("/a/b", [&names] (Ptr<const cs::Entry> entry) {
+      names.insert(entry->GetName());
+    });
+  BOOST_CHECK(names == std::set<Name>({"/a/b/1", "/a/b/2"}));
+
+  // counters are updated on eviction
+  cs->SetAttribute("MaxSize", StringValue("3"));
+  cs->Add(make_shared<Data>("/x"));
+  BOOST_CHECK_EQUAL(cs->CountUnderPrefix("/"), cs->GetSize());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-rsu-coordinator.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnRsuCoordinator, CleanupFixture)
+
+static Ptr<RsuCoordinator>
+makeCoordinator(uint32_t region)
+{
+  Ptr<RsuCoordinator> coordinator = CreateObject<RsuCoordinator>();
+  coordinator->SetAttribute("Region", UintegerValue(region));
+  return coordinator;
+}
+
+BOOST_AUTO_TEST_CASE(Regions)
+{
+  Ptr<RsuCoordinator> rsu1 = makeCoordinator(1);
+  Ptr<RsuCoordinator> rsu2 = makeCoordinator(1);
+  Ptr<RsuCoordinator> rsu3 = makeCoordinator(2);
+
+  std::vector<Name> notified2;
+  std::vector<Name> notified3;
+  rsu2->Subscribe("/criticalData", [&notified2] (const Name& name) { notified2.push_back(name); });
+  rsu3->Subscribe("/criticalData", [&notified3] (const Name& name) { notified3.push_back(name); });
+
+  BOOST_CHECK(!rsu2->IsDiscovered("/criticalData"));
+
+  rsu1->ReportDiscovery("/criticalData/test");
+  rsu1->ReportDiscovery("/criticalData/test"); // already discovered
+  rsu1->ReportDiscovery("/other/test");
+
+  BOOST_REQUIRE_EQUAL(notified2.size(), 1U);
+  BOOST_CHECK_EQUAL(notified2[0], Name("/criticalData/test"));
+  BOOST_CHECK(notified3.empty());
+
+  BOOST_CHECK(rsu2->IsDiscovered("/criticalData"));
+  BOOST_CHECK(rsu2->IsDiscovered("/criticalData/test"));
+  BOOST_CHECK(!rsu2->IsDiscovered("/criticalData/test2"));
+  BOOST_CHECK(!rsu3->IsDiscovered("/criticalData"));
+
+  rsu3->ReportDiscovery("/criticalData/other");
+  BOOST_CHECK_EQUAL(notified2.size(), 1U);
+  BOOST_CHECK_EQUAL(notified3.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(SubscribeAfterDiscovery)
+{
+  Ptr<RsuCoordinator> rsu1 = makeCoordinator(0);
+  Ptr<RsuCoordinator> rsu2 = makeCoordinator(0);
+
+  rsu1->ReportDiscovery("/criticalData/a");
+  rsu1->ReportDiscovery("/criticalData/b");
+
+  std::vector<Name> notified;
+  uint64_t subscriptionId =
+    rsu2->Subscribe("/criticalData", [&notified] (const Name& name) { notified.push_back(name); });
+  BOOST_CHECK_EQUAL(notified.size(), 2U);
+
+  rsu2->Unsubscribe(subscriptionId);
+  rsu1->ReportDiscovery("/criticalData/c");
+  BOOST_CHECK_EQUAL(notified.size(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE(ReleasedWithLastCoordinator)
+{
+  Ptr<RsuCoordinator> rsu1 = makeCoordinator(0);
+  Ptr<RsuCoordinator> rsu2 = makeCoordinator(0);
+  rsu2->Subscribe("/criticalData", [] (const Name&) {});
+
+  rsu1->ReportDiscovery("/criticalData/a");
+  rsu1->Dispose();
+  BOOST_CHECK(rsu2->IsDiscovered("/criticalData"));
+
+  rsu2->Dispose();
+  BOOST_CHECK(!makeCoordinator(0)->IsDiscovered("/criticalData"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnDataTemplate)
+
+static Data
+makePrototype(const Name& keyLocator)
+{
+  Data data;
+  data.setFreshnessPeriod(time::milliseconds(2000));
+  data.setContent(make_shared< ::ndn::Buffer>(1024));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 7));
+  data.setSignature(signature);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(SameAsFieldByField)
+{
+  for (const Name& keyLocator : {Name(), Name("/key/locator")}) {
+    Data prototype = makePrototype(keyLocator);
+    DataTemplate dataTemplate(prototype);
+
+    for (const Name& name : {Name("/"), Name("/prefix"), Name("/prefix").appendSequenceNumber(1000),
+                             Name("/a/very/long/name/with/many/components/to/need/wider/length")}) {
+      shared_ptr<Data> data = dataTemplate.Make(name);
+
+      Data expected(prototype);
+      expected.setName(name);
+
+      BOOST_CHECK_EQUAL(data->getName(), name);
+      BOOST_CHECK_EQUAL(data->getContent().value_size(), 1024U);
+      BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), time::milliseconds(2000));
+      BOOST_CHECK(data->wireEncode() == expected.wireEncode());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LargePayload)
+{
+  // total length needs a wider TLV length than the prototype
+  Data prototype;
+  prototype.setContent(make_shared< ::ndn::Buffer>(70000));
+  prototype.setSignature(makePrototype(Name()).getSignature());
+
+  DataTemplate dataTemplate(prototype);
+  shared_ptr<Data> data = dataTemplate.Make("/prefix/name");
+
+  Data expected(prototype);
+  expected.setName("/prefix/name");
+  BOOST_CHECK(data->wireEncode() == expected.wireEncode());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
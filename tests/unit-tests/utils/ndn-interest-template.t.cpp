@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-interest-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnInterestTemplate)
+
+BOOST_AUTO_TEST_CASE(WithoutSequenceNumber)
+{
+  Interest prototype("/prefix/name");
+  prototype.setCanBePrefix(true);
+  prototype.setInterestLifetime(time::milliseconds(1500));
+  prototype.setMustBeFresh(true);
+
+  InterestTemplate interestTemplate(prototype);
+
+  for (uint32_t nonce : {0u, 1u, 0xDEADBEEFu}) {
+    shared_ptr<Interest> interest = interestTemplate.Make(nonce);
+
+    Interest expected(prototype);
+    expected.setNonce(nonce);
+
+    BOOST_CHECK_EQUAL(interest->getName(), expected.getName());
+    BOOST_CHECK_EQUAL(interest->getNonce(), nonce);
+    BOOST_CHECK(interest->getMustBeFresh());
+    BOOST_CHECK_EQUAL(interest->getInterestLifetime(), time::milliseconds(1500));
+    BOOST_CHECK(interest->wireEncode() == expected.wireEncode());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(WithSequenceNumber)
+{
+  Interest prototype("/prefix");
+  InterestTemplate interestTemplate(prototype, true);
+
+  for (uint32_t seq : {0u, 1u, 255u, 256u, 65535u, 65536u, 4000000000u}) {
+    shared_ptr<Interest> interest = interestTemplate.Make(seq, 42);
+
+    Interest expected(Name("/prefix").appendSequenceNumber(seq));
+    expected.setNonce(42);
+
+    BOOST_CHECK_EQUAL(interest->getName(), expected.getName());
+    BOOST_CHECK_EQUAL(interest->getName().at(-1).toSequenceNumber(), seq);
+    BOOST_CHECK(interest->wireEncode() == expected.wireEncode());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-log-linear-histogram.hpp"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnLogLinearHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Exact)
+{
+  LogLinearHistogram histogram(5);
+  for (uint64_t value = 1; value <= 20; value++) {
+    histogram.Record(value);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 20U);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 1U);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 20U);
+  BOOST_CHECK_CLOSE(histogram.GetMean(), 10.5, 0.001);
+
+  // values below 32 have their own buckets
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(0), 1U);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 10U);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(90), 18U);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 20U);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  LogLinearHistogram histogram(5);
+  std::vector<uint64_t> values;
+  for (uint64_t value = 1000; value < 10000000; value = value * 11 / 10) {
+    histogram.Record(value);
+    values.push_back(value);
+  }
+
+  for (double percentile : {10.0, 50.0, 90.0, 99.0}) {
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100 * values.size()));
+    uint64_t exact = values[rank - 1];
+    uint64_t estimate = histogram.GetPercentile(percentile);
+
+    BOOST_CHECK_GE(estimate, exact);
+    BOOST_CHECK_LE(estimate - exact, exact / 32);
+  }
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), values.back());
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  LogLinearHistogram histogram;
+  histogram.Record(1000000);
+  histogram.Reset();
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0U);
+
+  histogram.Record(0);
+  histogram.Record(7);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 0U);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 0U);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(99), 7U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
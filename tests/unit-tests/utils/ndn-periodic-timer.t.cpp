@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-periodic-timer.hpp"
+
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnPeriodicTimer, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Duration)
+{
+  std::vector<Time> expirations;
+  std::vector<bool> isLast;
+  PeriodicTimer timer;
+  timer.SetFunction([&] {
+      expirations.push_back(Simulator::Now());
+      isLast.push_back(!timer.IsRunning());
+    });
+
+  Simulator::Schedule(Seconds(2), [&timer] { timer.Start(Seconds(1), Seconds(5)); });
+  Simulator::Run();
+
+  // same as scheduling Seconds(i) for i in [1, 5)
+  BOOST_REQUIRE_EQUAL(expirations.size(), 4U);
+  BOOST_CHECK_EQUAL(expirations.front(), Seconds(3));
+  BOOST_CHECK_EQUAL(expirations.back(), Seconds(6));
+  BOOST_CHECK(!isLast[2]);
+  BOOST_CHECK(isLast[3]);
+  BOOST_CHECK(!timer.IsRunning());
+}
+
+BOOST_AUTO_TEST_CASE(OnePendingEvent)
+{
+  uint32_t nExpirations = 0;
+  PeriodicTimer timer([&nExpirations] { nExpirations++; });
+  timer.Start(MilliSeconds(100));
+  BOOST_CHECK(timer.IsRunning());
+
+  Simulator::Stop(Seconds(10.05));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nExpirations, 100U);
+  BOOST_CHECK_EQUAL(Simulator::GetEventCount(), 100U + 1); // expirations and stop
+}
+
+BOOST_AUTO_TEST_CASE(Stop)
+{
+  uint32_t nExpirations = 0;
+  PeriodicTimer timer;
+  timer.SetFunction([&] {
+      if (++nExpirations == 3) {
+        timer.Stop();
+      }
+    });
+  timer.Start(Seconds(1), Seconds(100));
+
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nExpirations, 3U);
+  BOOST_CHECK_EQUAL(Simulator::Now(), Seconds(3));
+
+  // no expirations
+  timer.Start(Seconds(1), Seconds(1));
+  BOOST_CHECK(!timer.IsRunning());
+}
+
+BOOST_AUTO_TEST_CASE(StartAt)
+{
+  std::vector<Time> expirations;
+  PeriodicTimer timer([&expirations] { expirations.push_back(Simulator::Now()); });
+
+  // restarted between whole seconds, expirations stay on whole seconds
+  Simulator::Schedule(Seconds(2.5), [&timer] { timer.StartAt(Seconds(3), Seconds(1)); });
+  Simulator::Schedule(Seconds(4.2), [&timer] { timer.Stop(); });
+  Simulator::Schedule(Seconds(6.7), [&timer] { timer.StartAt(Seconds(7), Seconds(1)); });
+  Simulator::Stop(Seconds(9.5));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(expirations.size(), 5U);
+  BOOST_CHECK_EQUAL(expirations[0], Seconds(3));
+  BOOST_CHECK_EQUAL(expirations[1], Seconds(4));
+  BOOST_CHECK_EQUAL(expirations[2], Seconds(7));
+  BOOST_CHECK_EQUAL(expirations[4], Seconds(9));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-popularity-table.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnPopularityTable)
+
+BOOST_AUTO_TEST_CASE(SharedRegistry)
+{
+  shared_ptr<const PopularityTable> table1 = PopularityTable::Get(1000, 0.7, 0.7);
+  shared_ptr<const PopularityTable> table2 = PopularityTable::Get(1000, 0.7, 0.7);
+  shared_ptr<const PopularityTable> table3 = PopularityTable::Get(1000, 0.7, 0.8);
+
+  BOOST_CHECK_EQUAL(table1, table2);
+  BOOST_CHECK_NE(table1, table3);
+
+  BOOST_CHECK_EQUAL(table1->GetN(), 1000);
+  BOOST_CHECK_EQUAL(table1->GetCumulative(0), 0.0);
+  BOOST_CHECK_EQUAL(table1->GetCumulative(1000), 1.0);
+
+  BOOST_CHECK_EQUAL(table1->Sample(1e-9), 1);
+  BOOST_CHECK_EQUAL(table1->Sample(table1->GetCumulative(10)), 10);
+  BOOST_CHECK_EQUAL(table1->Sample(table1->GetCumulative(10) + 1e-12), 11);
+  BOOST_CHECK_EQUAL(table1->Sample(1.0), 1000);
+
+  // released with the last user
+  std::weak_ptr<const PopularityTable> released = table3;
+  table3.reset();
+  BOOST_CHECK(released.expired());
+}
+
+BOOST_AUTO_TEST_CASE(PrecomputedFile)
+{
+  boost::filesystem::path file = boost::filesystem::path(TEST_CONFIG_PATH) / "popularity.bin";
+  boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+  BOOST_REQUIRE(PopularityTable::Save(file.string(), 500, 0.5, 0.9));
+
+  shared_ptr<const PopularityTable> loaded = PopularityTable::Load(file.string());
+  shared_ptr<const PopularityTable> computed = PopularityTable::Get(500, 0.5, 0.9);
+  BOOST_CHECK_EQUAL(loaded, PopularityTable::Load(file.string()));
+
+  BOOST_CHECK_EQUAL(loaded->GetN(), 500);
+  BOOST_CHECK_EQUAL(loaded->GetQ(), 0.5);
+  BOOST_CHECK_EQUAL(loaded->GetS(), 0.9);
+  for (uint32_t k = 0; k <= 500; k++) {
+    BOOST_CHECK_EQUAL(loaded->GetCumulative(k), computed->GetCumulative(k));
+  }
+
+  loaded.reset();
+  boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-rtt-seq-mean-deviation.hpp"
+
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRttSeqMeanDeviation, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(OutOfOrderAcks)
+{
+  Ptr<RttSeqMeanDeviation> rtt = CreateObject<RttSeqMeanDeviation>();
+  std::vector<Time> samples;
+  auto ack = [&] (uint32_t seq) { samples.push_back(rtt->AckSeq(SequenceNumber32(seq))); };
+
+  Simulator::Schedule(Seconds(0), [&] {
+      for (uint32_t seq = 0; seq < 4; seq++) {
+        rtt->SentSeq(SequenceNumber32(seq), 1);
+      }
+    });
+  Simulator::Schedule(Seconds(0.1), ack, 2);
+  Simulator::Schedule(Seconds(0.2), ack, 0);
+  Simulator::Schedule(Seconds(0.3), [&] {
+      rtt->TimeoutSeq(SequenceNumber32(1));
+      rtt->SentSeq(SequenceNumber32(1), 1);
+      rtt->SentSeq(SequenceNumber32(3), 1); // sent again before the timer expired
+    });
+  Simulator::Schedule(Seconds(0.4), ack, 1);
+  Simulator::Schedule(Seconds(0.5), ack, 3);
+  Simulator::Schedule(Seconds(0.6), ack, 3); // duplicate Data
+
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(samples.size(), 5);
+  BOOST_CHECK_EQUAL(samples[0], Seconds(0.1));
+  BOOST_CHECK_EQUAL(samples[1], Seconds(0.2)); // out of order, still sampled
+  BOOST_CHECK_EQUAL(samples[2], Seconds(0));   // timed out
+  BOOST_CHECK_EQUAL(samples[3], Seconds(0));   // retransmitted
+  BOOST_CHECK_EQUAL(samples[4], Seconds(0));
+  BOOST_CHECK_EQUAL(rtt->GetHistorySize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AbandonedSequences)
+{
+  Ptr<RttSeqMeanDeviation> rtt = CreateObject<RttSeqMeanDeviation>();
+  for (uint32_t seq = 0; seq < 4; seq++) {
+    rtt->SentSeq(SequenceNumber32(seq), 1);
+  }
+  rtt->TimeoutSeq(SequenceNumber32(1));
+  BOOST_CHECK_EQUAL(rtt->GetHistorySize(), 4); // timed out records are kept
+
+  rtt->ClearSent();
+  BOOST_CHECK_EQUAL(rtt->GetHistorySize(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
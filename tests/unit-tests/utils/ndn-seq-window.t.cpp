@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-window.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnSeqWindow)
+
+BOOST_AUTO_TEST_CASE(SentFindErase)
+{
+  SeqWindow window(4);
+
+  for (uint32_t seq = 0; seq < 10; seq++) {
+    window.Sent(seq, Seconds(seq));
+  }
+  BOOST_CHECK_EQUAL(window.size(), 10);
+  BOOST_CHECK_EQUAL(window.GetCapacity(), 16);
+
+  // retransmission keeps the first send time
+  SeqWindow::Entry& entry = window.Sent(3, Seconds(20));
+  BOOST_CHECK_EQUAL(entry.firstSent, Seconds(3));
+  BOOST_CHECK_EQUAL(entry.lastSent, Seconds(20));
+  BOOST_CHECK_EQUAL(entry.retxCount, 2);
+
+  window.Erase(0);
+  window.Erase(5);
+  window.Erase(5);
+  BOOST_CHECK_EQUAL(window.size(), 8);
+  BOOST_CHECK(window.Find(0) == nullptr);
+  BOOST_CHECK(window.Find(5) == nullptr);
+  BOOST_CHECK(window.Find(100) == nullptr);
+  BOOST_REQUIRE(window.Find(9) != nullptr);
+  BOOST_CHECK_EQUAL(window.Find(9)->firstSent, Seconds(9));
+
+  // the window slides without growing
+  for (uint32_t seq = 10; seq < 1000; seq++) {
+    window.Erase(seq - 10);
+    window.Sent(seq, Seconds(seq));
+  }
+  BOOST_CHECK_EQUAL(window.size(), 10);
+  BOOST_CHECK_EQUAL(window.GetCapacity(), 16);
+
+  // sparse sequence numbers below and above the window
+  window.Sent(1, Seconds(1000));
+  window.Sent(5000, Seconds(1000));
+  BOOST_CHECK_EQUAL(window.size(), 12);
+  BOOST_REQUIRE(window.Find(995) != nullptr);
+  BOOST_CHECK_EQUAL(window.Find(995)->firstSent, Seconds(995));
+  BOOST_REQUIRE(window.Find(1) != nullptr);
+  BOOST_REQUIRE(window.Find(5000) != nullptr);
+
+  window.Clear();
+  BOOST_CHECK(window.empty());
+  BOOST_CHECK(window.Find(995) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SparseSequenceNumbers)
+{
+  SeqWindow window(4);
+
+  // random sequence numbers of a large catalog, few outstanding
+  uint32_t seq = 1;
+  std::vector<uint32_t> outstanding;
+  for (uint32_t i = 0; i < 10000; i++) {
+    seq = (seq * 48271ULL) % 1000000 + 1;
+    window.Sent(seq, Seconds(i));
+    outstanding.push_back(seq);
+    if (outstanding.size() > 10) {
+      window.Erase(outstanding.front());
+      outstanding.erase(outstanding.begin());
+    }
+  }
+  BOOST_CHECK_EQUAL(window.size(), outstanding.size());
+  BOOST_CHECK_LE(window.GetCapacity(), 1024);
+  for (uint32_t outstandingSeq : outstanding) {
+    BOOST_CHECK(window.Find(outstandingSeq) != nullptr);
+  }
+  BOOST_CHECK(window.Find(seq + 1) == nullptr);
+
+  Time start;
+  BOOST_REQUIRE(window.GetEarliestTimeout(start));
+  BOOST_CHECK_EQUAL(start, Seconds(10000 - outstanding.size()));
+
+  // the ring is used again once the window is empty
+  for (uint32_t outstandingSeq : outstanding) {
+    window.Erase(outstandingSeq);
+  }
+  BOOST_CHECK(window.empty());
+  for (uint32_t i = 0; i < 100; i++) {
+    window.Sent(i, Seconds(i));
+    window.Erase(i);
+  }
+  window.Sent(100, Seconds(100));
+  BOOST_REQUIRE(window.Find(100) != nullptr);
+  BOOST_CHECK_LE(window.GetCapacity(), 1024);
+}
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  SeqWindow window;
+
+  window.Sent(1, Seconds(1));
+  window.Sent(2, Seconds(2));
+  window.Sent(3, Seconds(3));
+  window.Erase(2);
+  // timer is already pending, retransmission does not restart it
+  window.Sent(1, Seconds(1.5));
+  BOOST_CHECK_EQUAL(window.GetArmedCount(), 2);
+
+  std::vector<uint32_t> expired;
+  auto collect = [&expired] (uint32_t seq) { expired.push_back(seq); };
+
+  window.ExpireTimeouts(Seconds(1), Seconds(1.9), collect);
+  BOOST_CHECK_EQUAL(expired.size(), 0);
+
+  window.ExpireTimeouts(Seconds(1), Seconds(3.5), collect);
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired[0], 1);
+  BOOST_CHECK_EQUAL(window.GetArmedCount(), 1);
+
+  // record stays until Data arrives, retransmission re-arms the timer
+  BOOST_REQUIRE(window.Find(1) != nullptr);
+  BOOST_CHECK(!window.Find(1)->timerArmed);
+  window.Sent(1, Seconds(3.5));
+
+  window.ExpireTimeouts(Seconds(1), Seconds(10), collect);
+  BOOST_REQUIRE_EQUAL(expired.size(), 3);
+  BOOST_CHECK_EQUAL(expired[1], 3);
+  BOOST_CHECK_EQUAL(expired[2], 1);
+  BOOST_CHECK_EQUAL(window.GetArmedCount(), 0);
+  BOOST_CHECK_EQUAL(window.Find(1)->retxCount, 3);
+}
+
+BOOST_AUTO_TEST_CASE(EarliestTimeout)
+{
+  SeqWindow window;
+  Time start;
+
+  BOOST_CHECK(!window.GetEarliestTimeout(start));
+
+  window.Sent(1, Seconds(1));
+  window.Sent(2, Seconds(2));
+  BOOST_REQUIRE(window.GetEarliestTimeout(start));
+  BOOST_CHECK_EQUAL(start, Seconds(1));
+
+  // stale timer of the satisfied Interest is skipped
+  window.Erase(1);
+  BOOST_REQUIRE(window.GetEarliestTimeout(start));
+  BOOST_CHECK_EQUAL(start, Seconds(2));
+
+  window.Erase(2);
+  BOOST_CHECK(!window.GetEarliestTimeout(start));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -22,6 +22,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <algorithm>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
@@ -143,6 +145,30 @@ BOOST_AUTO_TEST_CASE(InstallNode)
 )STR");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllHistograms)
+{
+  AppDelayTracer::InstallAllHistograms(TEST_TRACE.string(), Seconds(1), {50});
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written, including the last period
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+  std::string trace = buffer.str();
+
+  // header, and min, mean, p50, and max of both types in 3 periods with Data
+  BOOST_CHECK_EQUAL(std::count(trace.begin(), trace.end(), '\n'), 1 + 3 * 2 * 4);
+  BOOST_CHECK_EQUAL(trace.substr(0, trace.find('\n')),
+                    "Time	Node	AppId	Type	Samples	Statistic	DelayS	DelayUS	RetxCount	HopCount");
+
+  BOOST_CHECK(trace.find("1	1	0	FullDelay	1	p50	0.041796	41796	1	2\n") != std::string::npos);
+  BOOST_CHECK(trace.find("3	2	0	LastDelay	1	mean	0	0	1	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("4	2	0	FullDelay	1	max	0.020898	20898	1	1\n") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 {
   auto output = make_shared<boost::test_tools::output_test_stream>();
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-async-output-stream.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnAsyncOutputStream, CleanupFixture)
+
+/**
+ * @brief Stream buffer that takes 1ms to write anything
+ */
+class SlowBuffer : public std::stringbuf {
+protected:
+  virtual std::streamsize
+  xsputn(const char* s, std::streamsize n)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return std::stringbuf::xsputn(s, n);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  auto output = make_shared<std::ostringstream>();
+  std::ostringstream expected;
+  {
+    AsyncOutputStream os(output, 7, 2);
+    for (int i = 0; i < 1000; i++) {
+      os << i << "\t" << std::string(i % 20, 'x') << "\n";
+      expected << i << "\t" << std::string(i % 20, 'x') << "\n";
+    }
+    os.flush();
+    BOOST_CHECK(os.good());
+    BOOST_CHECK_EQUAL(output->str(), expected.str());
+
+    os << "last" << '\n';
+    expected << "last" << '\n';
+  }
+  // written by destructor
+  BOOST_CHECK_EQUAL(output->str(), expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(Backpressure)
+{
+  SlowBuffer buffer;
+  auto output = make_shared<std::ostream>(&buffer);
+
+  AsyncOutputStream os(output, 10, 2);
+  for (int i = 0; i < 10; i++) {
+    os << "0123456789";
+  }
+  BOOST_CHECK_GT(os.GetNStalls(), 0U);
+
+  os.flush();
+  BOOST_CHECK_EQUAL(buffer.str().size(), 100U);
+}
+
+BOOST_AUTO_TEST_CASE(Failure)
+{
+  auto output = make_shared<std::ostringstream>();
+  output->setstate(std::ios_base::badbit);
+
+  AsyncOutputStream os(output, 10, 2);
+  os << "record\n";
+  BOOST_CHECK(os.good()); // not written yet
+  os.flush();
+  BOOST_CHECK(os.bad());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
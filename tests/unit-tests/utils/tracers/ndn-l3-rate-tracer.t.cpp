@@ -18,6 +18,7 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "utils/tracers/ndn-tracer-registry.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
@@ -28,6 +29,8 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,6 +58,7 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     L3RateTracer::Destroy(); // additional cleanup
   }
 };
@@ -119,6 +123,104 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(BinaryTrace)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::Install(nodes, TEST_BINARY_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_BINARY_TRACE.string().c_str(), std::ios_base::binary);
+  BinaryTraceReader reader(is);
+  BOOST_CHECK_EQUAL(reader.GetSchema().size(), L3RateTracer::GetSchema().size());
+
+  auto text = make_shared<std::ostringstream>();
+  TsvTraceSink sink(text, reader.GetSchema());
+  BOOST_CHECK_EQUAL(reader.ReadAll(sink), 32U);
+
+  std::string trace = text->str();
+  BOOST_CHECK_EQUAL(trace.substr(0, trace.find('\n')),
+                    "Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	KilobytesRaw");
+  BOOST_CHECK(trace.find("1	1	257	appFace://	InInterests	0.8	0	1	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("1	1	-1	all	TimedOutInterests	0.8	0	1	0\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Aggregated)
+{
+  Ptr<Node> idle = CreateObject<Node>();
+  StackHelper ndnHelper;
+  ndnHelper.Install(idle);
+
+  NodeContainer nodes;
+  nodes.Add(idle);
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::InstallAggregated(nodes, TEST_TRACE.string(), Seconds(1), {0, 50, 100});
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string trace((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+  // the idle node counts as zero
+  BOOST_CHECK(trace.find("1	sum	-1	all	InInterests	0.8	0	1	0\n"
+                         "1	p0	-1	all	InInterests	0	0	0	0\n"
+                         "1	p50	-1	all	InInterests	0	0	0	0\n"
+                         "1	p100	-1	all	InInterests	0.8	0	1	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("1	sum	-1	all	TimedOutInterests	0.8	0	1	0\n") != std::string::npos);
+
+  // no per-node records
+  BOOST_CHECK(trace.find("appFace://") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(SharedFile)
+{
+  Ptr<Node> other = CreateObject<Node>();
+  Names::Add("other", other);
+  StackHelper ndnHelper;
+  ndnHelper.Install(other);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("1"));
+  consumerHelper.Install(other).Stop(Seconds(0.9));
+
+  // installed separately into the same file, printed by one timer in the order of node IDs
+  L3RateTracer::Install(other, TEST_TRACE.string(), Seconds(1));
+  L3RateTracer::Install(getNode("1"), TEST_TRACE.string(), Seconds(1));
+
+  shared_ptr<TraceSink> sink = TracerRegistry::Open(TEST_TRACE.string(),
+                                                    L3RateTracer::GetSchema());
+  BOOST_CHECK_EQUAL(TracerRegistry::Find<L3RateTracer>(sink).size(), 1U);
+
+  // a different period needs its own timer
+  L3RateTracer::Install(other, TEST_TRACE.string(), Seconds(2));
+  BOOST_CHECK_EQUAL(TracerRegistry::Find<L3RateTracer>(sink).size(), 2U);
+  sink.reset();
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string trace((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+  size_t node1 = trace.find("1	1	257	appFace://	InInterests	0.8	0	1	0\n");
+  size_t nodeOther = trace.find("1	other	");
+  BOOST_REQUIRE(node1 != std::string::npos);
+  BOOST_REQUIRE(nodeOther != std::string::npos);
+  BOOST_CHECK_LT(node1, nodeOther);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-tables-tracer.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class TablesTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TablesTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "0.9s"}, // send just one packet
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~TablesTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    TablesTracer::Destroy(); // additional cleanup
+  }
+
+  std::string
+  readTrace()
+  {
+    std::ifstream is(TEST_TRACE.string().c_str());
+    return std::string((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTablesTracer, TablesTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Sizes)
+{
+  TablesTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  TablesTracer::Destroy(); // to force log to be written
+
+  std::string trace = readTrace();
+  BOOST_CHECK_EQUAL(trace.substr(0, trace.find('\n')), "Time	Node	Type	Statistic	Value");
+  BOOST_CHECK(trace.find("1	1	PitEntries	size	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("1	2	PitEntries	size	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("1	1	FibEntries	size	") != std::string::npos);
+  BOOST_CHECK(trace.find("1	1	MeasurementsEntries	size	") != std::string::npos);
+  BOOST_CHECK(trace.find("1	2	CsEntries	size	1\n") != std::string::npos);
+  BOOST_CHECK(trace.find("PitLifetime") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(PitLifetimes)
+{
+  TablesTracer::Install(getNode("1"), TEST_TRACE.string(), Seconds(1), true);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  TablesTracer::Destroy(); // to force log to be written
+
+  std::string trace = readTrace();
+  BOOST_CHECK(trace.find("1	1	SatisfiedPitLifetime	count	1\n"
+                         "1	1	SatisfiedPitLifetime	min	0.02") != std::string::npos);
+  BOOST_CHECK(trace.find("1	1	TimedOutPitLifetime	count	0\n") != std::string::npos);
+  BOOST_CHECK(trace.find("1	2	") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-filter.hpp"
+
+#include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
+
+#include <ndn-cxx/face.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TraceFilterFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TraceFilterFixture()
+    : nOutInterests(0)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "100"}},
+            "0s", "1s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    getNode("2")->GetObject<L3Protocol>()->TraceConnectWithoutContext(
+      "OutInterests", MakeCallback(&TraceFilterFixture::OutInterests, this));
+  }
+
+  void
+  OutInterests(const Interest&, const Face&)
+  {
+    nOutInterests++;
+  }
+
+  void
+  InInterests(const Interest& interest, const Face&)
+  {
+    inInterests.insert(interest.getName());
+  }
+
+  void
+  OutData(const Data& data, const Face&)
+  {
+    outData.insert(data.getName());
+  }
+
+public:
+  size_t nOutInterests;
+  std::set<Name> inInterests;
+  std::set<Name> outData;
+};
+
+/**
+ * @brief Producer answering Interests with Data, whose names have an additional component
+ */
+class PostfixProducer
+{
+public:
+  PostfixProducer(const Name& prefix, const name::Component& postfix)
+  {
+    auto onInterest = [this, postfix] (const ::ndn::InterestFilter&, const Interest& interest) {
+      auto data = make_shared<Data>(Name(interest.getName()).append(postfix));
+      StackHelper::getKeyChain().sign(*data);
+      m_face.put(*data);
+    };
+    m_face.setInterestFilter(prefix, onInterest, [] (const Name&, const std::string&) {
+        BOOST_ERROR("Unexpected failure to set interest filter");
+      });
+  }
+
+private:
+  ::ndn::Face m_face;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceFilter, TraceFilterFixture)
+
+BOOST_AUTO_TEST_CASE(Prefixes)
+{
+  TraceFilter filter;
+  BOOST_CHECK(filter.IsTraced("/a/1"));
+
+  filter.SetSamplingInterval(0);
+  BOOST_CHECK(!filter.IsTraced("/a/1"));
+
+  filter.AddPrefix("/a");
+  filter.AddPrefix("/a/b", 0);
+  BOOST_CHECK(filter.IsTraced("/a/1"));
+  BOOST_CHECK(filter.IsTraced("/a"));
+  BOOST_CHECK(!filter.IsTraced("/a/b/1"));
+  BOOST_CHECK(!filter.IsTraced("/b/1"));
+
+  filter.AddPrefix("/a/b", 1);
+  BOOST_CHECK(filter.IsTraced("/a/b/1"));
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  TraceFilter filter;
+  filter.AddPrefix("/a", 4);
+
+  size_t nTraced = 0;
+  for (uint64_t i = 0; i < 10000; i++) {
+    Name name = Name("/a").appendSequenceNumber(i);
+    bool isTraced = filter.IsTraced(name);
+    BOOST_CHECK_EQUAL(filter.IsTraced(name), isTraced); // the same for every packet
+    nTraced += isTraced;
+  }
+  BOOST_CHECK_GT(nTraced, 2300U);
+  BOOST_CHECK_LT(nTraced, 2700U);
+}
+
+BOOST_AUTO_TEST_CASE(SampledComponents)
+{
+  TraceFilter filter;
+  filter.SetSamplingInterval(4);
+
+  size_t nDifferent = 0;
+  for (uint64_t i = 0; i < 1000; i++) {
+    Name name = Name("/a").appendSequenceNumber(i);
+    nDifferent += filter.IsTraced(name) != filter.IsTraced(Name(name).append("postfix"));
+  }
+  BOOST_CHECK_GT(nDifferent, 0U);
+
+  filter.SetSampledComponents(2);
+  for (uint64_t i = 0; i < 1000; i++) {
+    Name name = Name("/a").appendSequenceNumber(i);
+    BOOST_CHECK_EQUAL(filter.IsTraced(name), filter.IsTraced(Name(name).append("postfix")));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  Ptr<TraceFilter> filter = Create<TraceFilter>();
+  filter->SetSamplingInterval(0);
+  TraceFilter::Install(NodeContainer(getNode("2")), filter);
+  BOOST_CHECK(getNode("2")->GetObject<L3Protocol>()->getTraceFilter() == filter);
+
+  Simulator::Stop(Seconds(0.5));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nOutInterests, 0U);
+
+  // everything on node 2, nothing on the other nodes
+  TraceFilter::InstallOnly(NodeContainer(getNode("2")));
+  BOOST_CHECK(getNode("2")->GetObject<L3Protocol>()->isTraced("/prefix/1"));
+  BOOST_CHECK(!getNode("1")->GetObject<L3Protocol>()->isTraced("/prefix/1"));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+  BOOST_CHECK_GT(nOutInterests, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(PostfixProducerData)
+{
+  addRoutes({
+      {"1", "2", "/postfix", 1}
+    });
+  FactoryCallbackApp::Install(getNode("2"), [] () -> shared_ptr<void> {
+      return make_shared<PostfixProducer>("/postfix", name::Component("producer-2"));
+    })
+    .Start(Seconds(0));
+  addApps({
+      {"1", "ns3::ndn::ConsumerZipfMandelbrot",
+          {{"Prefix", "/postfix"}, {"Frequency", "100"}, {"NumberOfContents", "1000"}},
+          "0s", "1s"}
+    });
+
+  Ptr<TraceFilter> filter = Create<TraceFilter>();
+  filter->SetSamplingInterval(0);
+  filter->AddPrefix("/postfix", 2);
+  filter->SetSampledComponents(2);
+  TraceFilter::InstallAll(filter);
+
+  Ptr<L3Protocol> l3 = getNode("2")->GetObject<L3Protocol>();
+  l3->TraceConnectWithoutContext("InInterests",
+                                 MakeCallback(&TraceFilterFixture::InInterests, this));
+  l3->TraceConnectWithoutContext("OutData", MakeCallback(&TraceFilterFixture::OutData, this));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // Data of the sampled Interests, and only them, are reported
+  BOOST_CHECK_GT(inInterests.size(), 0U);
+  BOOST_CHECK_EQUAL(outData.size(), inInterests.size());
+  for (const Name& name : outData) {
+    BOOST_CHECK_EQUAL(name.size(), 3U);
+    BOOST_CHECK_EQUAL(inInterests.count(name.getPrefix(-1)), 1U);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, CleanupFixture)
+
+static const TraceSink::Schema SCHEMA = {
+  {"Time", TraceSink::COLUMN_DOUBLE},
+  {"Node", TraceSink::COLUMN_STRING},
+  {"FaceId", TraceSink::COLUMN_INTEGER},
+  {"Type", TraceSink::COLUMN_STRING},
+  {"Packets", TraceSink::COLUMN_DOUBLE}};
+
+static void
+addRecords(TraceSink& sink, size_t nRecords)
+{
+  for (size_t i = 0; i < nRecords; i++) {
+    sink.AddDouble(i * 0.5);
+    sink.AddString("node" + std::to_string(i % 10));
+    sink.AddInteger(static_cast<int64_t>(i % 5) - 1);
+    sink.AddString(i % 2 ? "InData" : "OutInterests");
+    sink.AddDouble(i % 3 * 0.8);
+    sink.EndRecord();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Tsv)
+{
+  auto os = make_shared<std::ostringstream>();
+  TsvTraceSink sink(os, SCHEMA);
+  addRecords(sink, 2);
+
+  BOOST_CHECK_EQUAL(os->str(), "Time	Node	FaceId	Type	Packets\n"
+                               "0	node0	-1	OutInterests	0\n"
+                               "0.5	node1	0	InData	0.8\n");
+}
+
+BOOST_AUTO_TEST_CASE(BinaryRoundTrip)
+{
+  auto text = make_shared<std::ostringstream>();
+  auto binary = make_shared<std::stringstream>();
+  {
+    TsvTraceSink tsv(text, SCHEMA);
+    addRecords(tsv, 1000);
+
+    // several blocks, the last one incomplete
+    BinaryTraceSink sink(binary, SCHEMA, 300);
+    addRecords(sink, 1000);
+  }
+  BOOST_CHECK_LT(binary->str().size(), text->str().size() / 4);
+
+  BinaryTraceReader reader(*binary);
+  BOOST_REQUIRE_EQUAL(reader.GetSchema().size(), SCHEMA.size());
+  BOOST_CHECK_EQUAL(reader.GetSchema()[1].name, "Node");
+  BOOST_CHECK_EQUAL(reader.GetSchema()[1].type, TraceSink::COLUMN_STRING);
+
+  auto converted = make_shared<std::ostringstream>();
+  TsvTraceSink tsv(converted, reader.GetSchema());
+  BOOST_CHECK_EQUAL(reader.ReadAll(tsv), 1000U);
+  BOOST_CHECK_EQUAL(converted->str(), text->str());
+}
+
+BOOST_AUTO_TEST_CASE(Flush)
+{
+  auto binary = make_shared<std::stringstream>();
+  BinaryTraceSink sink(binary, SCHEMA);
+  addRecords(sink, 10);
+  sink.Flush();
+  addRecords(sink, 10);
+  sink.Flush();
+
+  BinaryTraceReader reader(*binary);
+  auto converted = make_shared<std::ostringstream>();
+  TsvTraceSink tsv(converted, reader.GetSchema(), false);
+  BOOST_CHECK_EQUAL(reader.ReadAll(tsv), 20U);
+}
+
+class SyncCountingBuffer : public std::stringbuf {
+public:
+  int nSyncs = 0;
+
+protected:
+  int
+  sync() override
+  {
+    nSyncs++;
+    return std::stringbuf::sync();
+  }
+};
+
+BOOST_AUTO_TEST_CASE(FullBlockDoesNotFlushStream)
+{
+  SyncCountingBuffer buffer;
+  auto os = make_shared<std::ostream>(&buffer);
+  BinaryTraceSink sink(os, SCHEMA, 10);
+
+  addRecords(sink, 35);
+  BOOST_CHECK_EQUAL(buffer.nSyncs, 0);
+  size_t written = buffer.str().size();
+
+  sink.Flush();
+  BOOST_CHECK_EQUAL(buffer.nSyncs, 1);
+  BOOST_CHECK_GT(buffer.str().size(), written);
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  std::stringstream text("Time	Node\n");
+  BOOST_CHECK_THROW(BinaryTraceReader reader(text), BinaryTraceReader::Error);
+
+  auto binary = make_shared<std::stringstream>();
+  {
+    BinaryTraceSink sink(binary, SCHEMA);
+    addRecords(sink, 100);
+  }
+  std::string wire = binary->str();
+  std::stringstream truncated(wire.substr(0, wire.size() - 10));
+
+  BinaryTraceReader reader(truncated);
+  TsvTraceSink tsv(make_shared<std::ostringstream>(), reader.GetSchema());
+  BOOST_CHECK_THROW(reader.ReadAll(tsv), BinaryTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-tracer-registry.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+static const TraceSink::Schema SCHEMA = {
+  {"Time", TraceSink::COLUMN_DOUBLE},
+  {"Node", TraceSink::COLUMN_STRING}};
+
+class TracerRegistryFixture : public CleanupFixture
+{
+public:
+  TracerRegistryFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TracerRegistryFixture()
+  {
+    TracerRegistry::DestroyAll();
+    boost::filesystem::remove(TEST_TRACE);
+  }
+};
+
+class FlushCounter : public TracerGroup {
+public:
+  FlushCounter(shared_ptr<TraceSink> sink, std::vector<int>& flushes, int id)
+    : TracerGroup(sink)
+    , m_flushes(flushes)
+    , m_id(id)
+  {
+  }
+
+  virtual void
+  Flush() override
+  {
+    m_flushes.push_back(m_id);
+    TracerGroup::Flush();
+  }
+
+private:
+  std::vector<int>& m_flushes;
+  int m_id;
+};
+
+class TracerA {
+};
+
+class TracerB {
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTracerRegistry, TracerRegistryFixture)
+
+BOOST_AUTO_TEST_CASE(SharedFile)
+{
+  shared_ptr<TraceSink> first = TracerRegistry::Open(TEST_TRACE.string(), SCHEMA);
+  BOOST_REQUIRE(first != nullptr);
+  BOOST_CHECK(TracerRegistry::Open(TEST_TRACE.string(), SCHEMA) == first);
+
+  std::vector<int> flushes;
+  TracerRegistry::Add<TracerA>(Create<FlushCounter>(first, flushes, 1));
+  first->AddDouble(1);
+  first->AddString("1");
+  first->EndRecord();
+  TracerRegistry::Add<TracerA>(Create<FlushCounter>(first, flushes, 2));
+  first->AddDouble(1);
+  first->AddString("2");
+  first->EndRecord();
+  first.reset();
+
+  TracerRegistry::Destroy<TracerA>();
+  BOOST_CHECK(flushes == std::vector<int>({1, 2}));
+
+  // one header for both groups
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string trace((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  BOOST_CHECK_EQUAL(trace, "Time	Node\n"
+                           "1	1\n"
+                           "1	2\n");
+}
+
+BOOST_AUTO_TEST_CASE(DestroyAll)
+{
+  shared_ptr<TraceSink> sink = TracerRegistry::Open(TEST_TRACE.string(), SCHEMA);
+  BOOST_REQUIRE(sink != nullptr);
+
+  std::vector<int> flushes;
+  TracerRegistry::Add<TracerA>(Create<FlushCounter>(sink, flushes, 1));
+  TracerRegistry::Add<TracerB>(Create<FlushCounter>(sink, flushes, 2));
+  TracerRegistry::Add<TracerA>(Create<FlushCounter>(sink, flushes, 3));
+
+  TracerRegistry::Destroy<TracerB>();
+  BOOST_CHECK(flushes == std::vector<int>({2}));
+
+  TracerRegistry::DestroyAll();
+  BOOST_CHECK(flushes == std::vector<int>({2, 1, 3}));
+
+  TracerRegistry::DestroyAll();
+  BOOST_CHECK_EQUAL(flushes.size(), 3U);
+
+  // the file is reopened once all its groups are gone
+  sink.reset();
+  BOOST_CHECK(TracerRegistry::Open(TEST_TRACE.string(), SCHEMA) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
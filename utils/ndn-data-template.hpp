@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DATA_TEMPLATE_H
+#define NDN_DATA_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Pre-encoded Data, of which only the name changes
+ *
+ * MetaInfo, Content, SignatureInfo and SignatureValue of the prototype are encoded once and
+ * shared by all Data made from the template.  Make() writes the TLV header, the (already
+ * encoded) name and the shared elements into a single buffer and decodes the result, so the
+ * Data carries its wire encoding without building the payload and the signature per packet.
+ *
+ * Data made from the template are identical to the ones built field by field.
+ */
+class DataTemplate {
+public:
+  DataTemplate();
+
+  /**
+   * @param prototype Data with all fields except the name set
+   */
+  explicit DataTemplate(const Data& prototype);
+
+  /**
+   * @brief Make Data with the given name
+   * @pre template is not empty
+   */
+  shared_ptr<Data>
+  Make(const Name& name) const;
+
+  bool
+  empty() const
+  {
+    return m_tail == nullptr;
+  }
+
+private:
+  ConstBufferPtr m_tail; ///< @brief encoded elements of the prototype after the name
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DATA_TEMPLATE_H
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-interest-template.hpp"
+
+#include "ns3/assert.h"
+
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+InterestTemplate::InterestTemplate()
+  : m_hasSequenceNumber(false)
+{
+}
+
+InterestTemplate::InterestTemplate(const Interest& prototype, bool hasSequenceNumber)
+  : m_hasSequenceNumber(hasSequenceNumber)
+{
+  if (hasSequenceNumber) {
+    // sequence numbers are encoded as NonNegativeInteger of the minimal width
+    m_encodings.push_back(Prepare(prototype, true, 0xFF));
+    m_encodings.push_back(Prepare(prototype, true, 0xFFFF));
+    m_encodings.push_back(Prepare(prototype, true, 0xFFFFFFFF));
+  }
+  else {
+    m_encodings.push_back(Prepare(prototype, false, 0));
+  }
+}
+
+InterestTemplate::Encoding
+InterestTemplate::Prepare(const Interest& prototype, bool hasSequenceNumber, uint32_t seq)
+{
+  Interest interest(prototype);
+  if (hasSequenceNumber) {
+    Name name(prototype.getName());
+    name.appendSequenceNumber(seq);
+    interest.setName(name);
+  }
+  interest.setNonce(0);
+
+  Encoding encoding;
+  encoding.wire = interest.wireEncode();
+  encoding.wire.parse();
+
+  const Block& nonce = encoding.wire.get(::ndn::tlv::Nonce);
+  NS_ASSERT(nonce.value_size() == sizeof(uint32_t));
+  encoding.nonceOffset = nonce.value() - encoding.wire.wire();
+
+  encoding.seqOffset = 0;
+  encoding.seqLength = 0;
+  if (hasSequenceNumber) {
+    const Block& name = encoding.wire.get(::ndn::tlv::Name);
+    name.parse();
+    const Block& component = name.elements().back();
+    // the number is the tail of the component value (after the marker, if any)
+    encoding.seqLength = seq <= 0xFF ? 1 : (seq <= 0xFFFF ? 2 : 4);
+    encoding.seqOffset =
+      component.value() + component.value_size() - encoding.seqLength - encoding.wire.wire();
+  }
+
+  return encoding;
+}
+
+shared_ptr<Interest>
+InterestTemplate::Make(uint32_t nonce) const
+{
+  NS_ASSERT(!empty() && !m_hasSequenceNumber);
+  return Make(m_encodings[0], 0, nonce);
+}
+
+shared_ptr<Interest>
+InterestTemplate::Make(uint32_t seq, uint32_t nonce) const
+{
+  NS_ASSERT(!empty() && m_hasSequenceNumber);
+  return Make(m_encodings[seq <= 0xFF ? 0 : (seq <= 0xFFFF ? 1 : 2)], seq, nonce);
+}
+
+shared_ptr<Interest>
+InterestTemplate::Make(const Encoding& encoding, uint32_t seq, uint32_t nonce) const
+{
+  auto buffer = make_shared<::ndn::Buffer>(encoding.wire.wire(), encoding.wire.size());
+  uint8_t* bytes = buffer->data();
+
+  // nonce is kept in host byte order, as Interest::setNonce does
+  std::memcpy(bytes + encoding.nonceOffset, &nonce, sizeof(nonce));
+
+  // NonNegativeInteger is big-endian
+  for (size_t i = encoding.seqLength; i > 0; i--) {
+    bytes[encoding.seqOffset + i - 1] = static_cast<uint8_t>(seq);
+    seq >>= 8;
+  }
+
+  return make_shared<Interest>(Block(buffer));
+}
+
+} // namespace ndn
+} // namespace ns3
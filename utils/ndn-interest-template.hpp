@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_INTEREST_TEMPLATE_H
+#define NDN_INTEREST_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Pre-encoded Interest, of which only the nonce and the sequence number change
+ *
+ * The prototype Interest is encoded once (once per encoded width of the sequence number, which
+ * is 1, 2 or 4 bytes for 32-bit numbers).  Make() copies the encoding, patches the nonce and the
+ * sequence number at known offsets and decodes the result, so the Interest carries its wire
+ * encoding and neither its name nor its wire needs to be built per packet.
+ *
+ * Interests made from the template are identical to the ones built field by field.
+ */
+class InterestTemplate {
+public:
+  InterestTemplate();
+
+  /**
+   * @param prototype Interest with all fields except the nonce set
+   * @param hasSequenceNumber whether Interests get a sequence number component appended to
+   *        the name of the prototype
+   */
+  explicit InterestTemplate(const Interest& prototype, bool hasSequenceNumber = false);
+
+  /**
+   * @brief Make Interest for the prototype name
+   * @pre template is created without sequence number
+   */
+  shared_ptr<Interest>
+  Make(uint32_t nonce) const;
+
+  /**
+   * @brief Make Interest for the prototype name with the sequence number appended
+   * @pre template is created with sequence number
+   */
+  shared_ptr<Interest>
+  Make(uint32_t seq, uint32_t nonce) const;
+
+  bool
+  empty() const
+  {
+    return m_encodings.empty();
+  }
+
+private:
+  struct Encoding {
+    Block wire;
+    size_t nonceOffset;
+    size_t seqOffset;
+    size_t seqLength;
+  };
+
+  static Encoding
+  Prepare(const Interest& prototype, bool hasSequenceNumber, uint32_t seq);
+
+  shared_ptr<Interest>
+  Make(const Encoding& encoding, uint32_t seq, uint32_t nonce) const;
+
+private:
+  bool m_hasSequenceNumber;
+  std::vector<Encoding> m_encodings; ///< @brief for 1, 2 and 4-byte sequence numbers
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_INTEREST_TEMPLATE_H
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-linear-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+LogLinearHistogram::LogLinearHistogram(uint8_t precision)
+  : m_precision(std::min<uint8_t>(precision, 16))
+  , m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+  , m_sum(0)
+{
+}
+
+void
+LogLinearHistogram::Record(uint64_t value)
+{
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index]++;
+
+  m_count++;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += value;
+}
+
+void
+LogLinearHistogram::Reset()
+{
+  m_counts.clear();
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint64_t
+LogLinearHistogram::GetPercentile(double percentile) const
+{
+  if (percentile <= 0 || m_count == 0) {
+    return m_min;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  uint64_t nValues = 0;
+  for (size_t index = 0; index < m_counts.size(); index++) {
+    nValues += m_counts[index];
+    if (nValues >= rank) {
+      return std::max(m_min, std::min(GetUpperBound(index), m_max));
+    }
+  }
+  return m_max;
+}
+
+size_t
+LogLinearHistogram::GetIndex(uint64_t value) const
+{
+  uint64_t nLinear = uint64_t(1) << m_precision;
+  if (value < nLinear) {
+    return value;
+  }
+
+  // value is in [2^msb, 2^(msb+1)), which is split into nLinear buckets
+  int msb = 0;
+  while ((value >> msb) > 1) {
+    msb++;
+  }
+  int shift = msb - m_precision;
+  return ((shift + 1) << m_precision) + ((value >> shift) - nLinear);
+}
+
+uint64_t
+LogLinearHistogram::GetUpperBound(size_t index) const
+{
+  uint64_t nLinear = uint64_t(1) << m_precision;
+  if (index < nLinear) {
+    return index;
+  }
+
+  int shift = (index >> m_precision) - 1;
+  uint64_t lower = (nLinear + (index & (nLinear - 1))) << shift;
+  return lower + ((uint64_t(1) << shift) - 1);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOG_LINEAR_HISTOGRAM_H
+#define NDN_LOG_LINEAR_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integers with log-linear buckets (as in HDR histograms)
+ *
+ * Values below 2^Precision have their own bucket.  Every larger power-of-two range
+ * [2^k, 2^(k+1)) is split into 2^Precision buckets of equal width, so percentiles are reported
+ * with a relative error below 2^-Precision.  Minimum, maximum, and mean are exact.
+ *
+ * Buckets are allocated up to the largest recorded value, so memory is bounded by the range of
+ * the values (e.g., about 500 counters for delays up to a minute in microseconds with the
+ * default precision) and not by the number of values.  Reset keeps the memory.
+ */
+class LogLinearHistogram {
+public:
+  static const uint8_t DEFAULT_PRECISION = 5;
+
+  explicit LogLinearHistogram(uint8_t precision = DEFAULT_PRECISION);
+
+  void
+  Record(uint64_t value);
+
+  /**
+   * @brief Remove all values
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @pre GetCount() > 0
+   */
+  uint64_t
+  GetMin() const
+  {
+    return m_min;
+  }
+
+  /**
+   * @pre GetCount() > 0
+   */
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @pre GetCount() > 0
+   */
+  double
+  GetMean() const
+  {
+    return m_sum / m_count;
+  }
+
+  /**
+   * @brief Get value at the percentile (nearest rank), e.g., 99 for the 99th percentile
+   *
+   * The returned value is the upper bound of the bucket (limited by the maximum), so at least
+   * the given percent of values are not larger than it.  The 0th percentile is the minimum.
+   *
+   * @pre GetCount() > 0
+   */
+  uint64_t
+  GetPercentile(double percentile) const;
+
+private:
+  size_t
+  GetIndex(uint64_t value) const;
+
+  uint64_t
+  GetUpperBound(size_t index) const;
+
+private:
+  uint8_t m_precision;
+  std::vector<uint64_t> m_counts; ///< @brief value count of each bucket
+
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_LINEAR_HISTOGRAM_H
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-periodic-timer.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+namespace ndn {
+
+PeriodicTimer::PeriodicTimer(const Function& function)
+  : m_function(function)
+{
+}
+
+PeriodicTimer::~PeriodicTimer()
+{
+  Stop();
+}
+
+void
+PeriodicTimer::SetFunction(const Function& function)
+{
+  m_function = function;
+}
+
+void
+PeriodicTimer::Start(Time period, Time duration)
+{
+  NS_ASSERT(period.IsStrictlyPositive());
+  Stop();
+
+  m_period = period;
+  Time now = Simulator::Now();
+  m_end = duration < Time::Max() - now ? now + duration : Time::Max();
+
+  if (now + m_period < m_end) {
+    m_event = Simulator::Schedule(m_period, &PeriodicTimer::Expire, this);
+  }
+}
+
+void
+PeriodicTimer::StartAt(Time first, Time period)
+{
+  NS_ASSERT(period.IsStrictlyPositive());
+  NS_ASSERT(first >= Simulator::Now());
+  Stop();
+
+  m_period = period;
+  m_end = Time::Max();
+  m_event = Simulator::Schedule(first - Simulator::Now(), &PeriodicTimer::Expire, this);
+}
+
+void
+PeriodicTimer::Stop()
+{
+  Simulator::Cancel(m_event);
+}
+
+bool
+PeriodicTimer::IsRunning() const
+{
+  return m_event.IsRunning();
+}
+
+void
+PeriodicTimer::Expire()
+{
+  // next expiration is scheduled first, so the function can stop the timer
+  if (Simulator::Now() + m_period < m_end) {
+    m_event = Simulator::Schedule(m_period, &PeriodicTimer::Expire, this);
+  }
+
+  if (m_function) {
+    m_function();
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PERIODIC_TIMER_H
+#define NDN_PERIODIC_TIMER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Self-rescheduling periodic timer
+ *
+ * Only the next expiration is scheduled in the simulator, so a timer running for the whole
+ * simulation costs one pending event instead of one event per period.
+ *
+ * The scheduled expiration refers to the timer, so the timer is not copyable and must not be
+ * moved while running.
+ */
+class PeriodicTimer : boost::noncopyable {
+public:
+  typedef std::function<void()> Function;
+
+  explicit PeriodicTimer(const Function& function = nullptr);
+
+  /**
+   * @brief Cancels the pending expiration
+   */
+  ~PeriodicTimer();
+
+  void
+  SetFunction(const Function& function);
+
+  /**
+   * @brief Call the function every @p period, until @p duration elapses (exclusive)
+   *
+   * The first call happens @p period after Start.  Restarting a running timer cancels the
+   * pending expiration.
+   */
+  void
+  Start(Time period, Time duration = Time::Max());
+
+  /**
+   * @brief Call the function at @p first and then every @p period, until stopped
+   *
+   * Used to keep expirations aligned to a grid (e.g., whole periods since some epoch) when the
+   * timer is restarted between grid points.  @p first is an absolute time, not in the past.
+   */
+  void
+  StartAt(Time first, Time period);
+
+  void
+  Stop();
+
+  /**
+   * @brief Whether another expiration is pending
+   *
+   * When called from the function, false means that the current expiration is the last one.
+   */
+  bool
+  IsRunning() const;
+
+  Time
+  GetPeriod() const
+  {
+    return m_period;
+  }
+
+private:
+  void
+  Expire();
+
+private:
+  Function m_function;
+  Time m_period;
+  Time m_end; ///< @brief absolute time, expirations happen strictly before it
+  EventId m_event;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PERIODIC_TIMER_H
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-popularity-table.hpp"
+
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PopularityTable");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'P', 'O', 'P', '0', '1'};
+
+/**
+ * @brief Header of the precomputed file, followed by N+1 doubles
+ */
+struct FileHeader {
+  char magic[8];
+  uint32_t n;
+  uint32_t reserved;
+  double q;
+  double s;
+};
+
+std::map<std::tuple<uint32_t, double, double>, std::weak_ptr<const PopularityTable>> g_computed;
+std::map<std::string, std::weak_ptr<const PopularityTable>> g_loaded;
+
+/**
+ * @brief Drop entries of tables that are no longer used
+ */
+template<class Map>
+void
+forgetExpiredTables(Map& tables)
+{
+  for (auto table = tables.begin(); table != tables.end();) {
+    if (table->second.expired()) {
+      table = tables.erase(table);
+    }
+    else {
+      ++table;
+    }
+  }
+}
+
+} // namespace
+
+shared_ptr<const PopularityTable>
+PopularityTable::Get(uint32_t n, double q, double s)
+{
+  forgetExpiredTables(g_computed);
+
+  std::weak_ptr<const PopularityTable>& cached = g_computed[std::make_tuple(n, q, s)];
+  shared_ptr<const PopularityTable> table = cached.lock();
+  if (table == nullptr) {
+    table.reset(new PopularityTable(n, q, s));
+    cached = table;
+  }
+  return table;
+}
+
+shared_ptr<const PopularityTable>
+PopularityTable::Load(const std::string& fileName)
+{
+  forgetExpiredTables(g_loaded);
+
+  std::weak_ptr<const PopularityTable>& cached = g_loaded[fileName];
+  shared_ptr<const PopularityTable> table = cached.lock();
+  if (table == nullptr) {
+    table.reset(new PopularityTable(fileName));
+    cached = table;
+  }
+  return table;
+}
+
+bool
+PopularityTable::Save(const std::string& fileName, uint32_t n, double q, double s)
+{
+  std::vector<double> pcum(static_cast<uint64_t>(n) + 1);
+  Compute(n, q, s, pcum.data());
+
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.n = n;
+  header.q = q;
+  header.s = s;
+
+  std::ofstream os(fileName.c_str(), std::ios_base::out | std::ios_base::binary);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << fileName << " cannot be opened for writing");
+    return false;
+  }
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(pcum.data()), pcum.size() * sizeof(double));
+  return static_cast<bool>(os);
+}
+
+PopularityTable::PopularityTable(uint32_t n, double q, double s)
+  : m_n(n)
+  , m_q(q)
+  , m_s(s)
+  , m_computed(static_cast<uint64_t>(n) + 1)
+  , m_mapped(nullptr)
+  , m_mappedSize(0)
+  , m_pcum(m_computed.data())
+{
+  Compute(n, q, s, m_computed.data());
+}
+
+PopularityTable::PopularityTable(const std::string& fileName)
+  : m_mapped(nullptr)
+  , m_mappedSize(0)
+{
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    NS_FATAL_ERROR("Cannot open popularity table " << fileName);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    NS_FATAL_ERROR("File " << fileName << " is not a popularity table");
+  }
+  m_mappedSize = info.st_size;
+
+  m_mapped = ::mmap(nullptr, m_mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (m_mapped == MAP_FAILED) {
+    m_mapped = nullptr;
+    NS_FATAL_ERROR("Cannot map popularity table " << fileName);
+  }
+
+  const FileHeader* header = static_cast<const FileHeader*>(m_mapped);
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+      || static_cast<uint64_t>(m_mappedSize)
+           != sizeof(FileHeader) + (static_cast<uint64_t>(header->n) + 1) * sizeof(double)) {
+    NS_FATAL_ERROR("File " << fileName << " is not a popularity table");
+  }
+
+  m_n = header->n;
+  m_q = header->q;
+  m_s = header->s;
+  m_pcum = reinterpret_cast<const double*>(header + 1);
+
+  NS_LOG_DEBUG("Mapped " << fileName << ": N=" << m_n << ", q=" << m_q << ", s=" << m_s);
+}
+
+PopularityTable::~PopularityTable()
+{
+  if (m_mapped != nullptr) {
+    ::munmap(m_mapped, m_mappedSize);
+  }
+}
+
+void
+PopularityTable::Compute(uint32_t n, double q, double s, double* pcum)
+{
+  NS_LOG_DEBUG(q << " and " << s << " and " << n);
+
+  // 64-bit index, so that the loops end for n == UINT32_MAX
+  pcum[0] = 0.0;
+  for (uint64_t i = 1; i <= n; i++) {
+    pcum[i] = pcum[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+
+  for (uint64_t i = 1; i <= n; i++) {
+    pcum[i] = pcum[i] / pcum[n];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << pcum[i]);
+  }
+}
+
+uint32_t
+PopularityTable::Sample(double p) const
+{
+  // first k in [1, N] with p <= pcum[k], where pcum[k] = pcum[k-1] + p[k]
+  const double* end = m_pcum + m_n + 1;
+  const double* found = std::lower_bound(m_pcum + 1, end, p);
+  if (found == end)
+    return 1;
+  return found - m_pcum;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_POPULARITY_TABLE_H
+#define NDN_POPULARITY_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Immutable cumulative Zipf-Mandelbrot popularity distribution over N contents
+ *
+ * Tables are obtained from a process-wide registry, so all consumers with identical (N, q, s)
+ * (or the same precomputed file) share one table, which is released together with the last
+ * consumer using it.
+ *
+ * A table can be precomputed with Save() and memory-mapped with Load(), so large catalogs are
+ * loaded without computing the distribution and pages are shared with other processes.
+ */
+class PopularityTable : boost::noncopyable {
+public:
+  /**
+   * @brief Get (compute if necessary) table with probability of rank k proportional to
+   *        1/(k+q)^s, k = 1..n
+   */
+  static shared_ptr<const PopularityTable>
+  Get(uint32_t n, double q, double s);
+
+  /**
+   * @brief Get (memory-map if necessary) table precomputed by Save()
+   *
+   * Fails with NS_FATAL_ERROR if the file cannot be mapped or is not a popularity table
+   */
+  static shared_ptr<const PopularityTable>
+  Load(const std::string& fileName);
+
+  /**
+   * @brief Compute table and write it into the file for Load()
+   * @returns false if the file cannot be written
+   */
+  static bool
+  Save(const std::string& fileName, uint32_t n, double q, double s);
+
+  ~PopularityTable();
+
+  /**
+   * @brief Map random value p in (0, 1] to a rank in [1, N] (binary search)
+   */
+  uint32_t
+  Sample(double p) const;
+
+  /**
+   * @brief Cumulative probability of ranks 1..k, k in [0, N]
+   */
+  double
+  GetCumulative(uint32_t k) const
+  {
+    return m_pcum[k];
+  }
+
+  uint32_t
+  GetN() const
+  {
+    return m_n;
+  }
+
+  double
+  GetQ() const
+  {
+    return m_q;
+  }
+
+  double
+  GetS() const
+  {
+    return m_s;
+  }
+
+private:
+  PopularityTable(uint32_t n, double q, double s);
+
+  PopularityTable(const std::string& fileName);
+
+  static void
+  Compute(uint32_t n, double q, double s, double* pcum);
+
+private:
+  uint32_t m_n;
+  double m_q;
+  double m_s;
+
+  std::vector<double> m_computed; ///< @brief storage of the computed table
+  void* m_mapped;                 ///< @brief mapped file (or nullptr)
+  size_t m_mappedSize;
+  const double* m_pcum;           ///< @brief N+1 cumulative probabilities
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_POPULARITY_TABLE_H
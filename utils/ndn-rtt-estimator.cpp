@@ -216,6 +216,13 @@ RttEstimator::AckSeq(SequenceNumber32 ackSeq)
   return m;
 }
 
+void
+RttEstimator::TimeoutSeq(SequenceNumber32 seq)
+{
+  NS_LOG_FUNCTION(this << seq);
+  SentSeq(seq, 1);
+}
+
 void
 RttEstimator::ClearSent()
 {
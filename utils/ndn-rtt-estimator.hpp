@@ -87,6 +87,16 @@ public:
   virtual Time
   AckSeq(SequenceNumber32 ackSeq);
 
+  /**
+   * \brief Note that retransmission timer of a particular sequence has expired
+   * \param seq the packet sequence number.
+   *
+   * Measurement for the sequence must not be taken anymore.  Default implementation marks the
+   * sequence as sent again.
+   */
+  virtual void
+  TimeoutSeq(SequenceNumber32 seq);
+
   /**
    * \brief Clear all history entries
    */
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-seq-mean-deviation.hpp"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttSeqMeanDeviation");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RttSeqMeanDeviation);
+
+TypeId
+RttSeqMeanDeviation::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RttSeqMeanDeviation")
+      .SetParent<RttMeanDeviation>()
+      .AddConstructor<RttSeqMeanDeviation>();
+  return tid;
+}
+
+RttSeqMeanDeviation::RttSeqMeanDeviation()
+{
+  NS_LOG_FUNCTION(this);
+}
+
+RttSeqMeanDeviation::RttSeqMeanDeviation(const RttSeqMeanDeviation& c)
+  : RttMeanDeviation(c)
+  , m_sent(c.m_sent)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+TypeId
+RttSeqMeanDeviation::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+void
+RttSeqMeanDeviation::SentSeq(SequenceNumber32 seq, uint32_t size)
+{
+  NS_LOG_FUNCTION(this << seq << size);
+
+  auto result = m_sent.insert(std::make_pair(seq.GetValue(), Sent{Simulator::Now(), false}));
+  if (!result.second) {
+    result.first->second.retx = true; // retransmission, the sample would be ambiguous
+  }
+}
+
+Time
+RttSeqMeanDeviation::AckSeq(SequenceNumber32 ackSeq)
+{
+  NS_LOG_FUNCTION(this << ackSeq);
+
+  Time m = Seconds(0.0);
+  auto sent = m_sent.find(ackSeq.GetValue());
+  if (sent == m_sent.end())
+    return m;
+
+  if (!sent->second.retx) {
+    m = Simulator::Now() - sent->second.time;
+    Measurement(m);
+    ResetMultiplier(); // Reset multiplier on valid measurement
+  }
+  m_sent.erase(sent);
+
+  return m;
+}
+
+void
+RttSeqMeanDeviation::TimeoutSeq(SequenceNumber32 seq)
+{
+  NS_LOG_FUNCTION(this << seq);
+
+  auto sent = m_sent.find(seq.GetValue());
+  if (sent != m_sent.end()) {
+    sent->second.retx = true;
+  }
+}
+
+void
+RttSeqMeanDeviation::ClearSent()
+{
+  NS_LOG_FUNCTION(this);
+  m_sent.clear();
+  RttMeanDeviation::ClearSent();
+}
+
+Ptr<RttEstimator>
+RttSeqMeanDeviation::Copy() const
+{
+  NS_LOG_FUNCTION(this);
+  return CopyObject<RttSeqMeanDeviation>(this);
+}
+
+void
+RttSeqMeanDeviation::Reset()
+{
+  NS_LOG_FUNCTION(this);
+  m_sent.clear();
+  RttMeanDeviation::Reset();
+}
+
+size_t
+RttSeqMeanDeviation::GetHistorySize() const
+{
+  return m_sent.size();
+}
+
+} // namespace ndn
+} // namespace ns3
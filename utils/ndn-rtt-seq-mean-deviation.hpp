@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_SEQ_MEAN_DEVIATION_H
+#define NDN_RTT_SEQ_MEAN_DEVIATION_H
+
+#include "ndn-rtt-mean-deviation.hpp"
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief "Mean--Deviation" RTT estimator with send history keyed by sequence number
+ *
+ * Data in NDN is not acknowledged cumulatively and may arrive in any order (e.g., from caches
+ * or with ConsumerZipfMandelbrot).  Instead of scanning the history list, this estimator keeps
+ * send times in a hash table indexed by the sequence number, so SentSeq, AckSeq and TimeoutSeq
+ * take constant time.  Every Data for a sequence number that was sent once gives an RTT sample.
+ * Sequence numbers which timed out or were sent again are not sampled (Karn's algorithm).  A
+ * record lives only while its Interest is outstanding: it is removed when Data arrives.  A timed
+ * out record is kept until the retransmission is answered, to suppress its ambiguous sample, so
+ * the owner should call ClearSent() when it abandons outstanding Interests (Consumer does so in
+ * StopApplication).
+ *
+ * Consumer uses RttMeanDeviation unless its RttEstimator attribute selects this estimator.
+ */
+class RttSeqMeanDeviation : public RttMeanDeviation {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  RttSeqMeanDeviation();
+  RttSeqMeanDeviation(const RttSeqMeanDeviation&);
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  virtual void
+  SentSeq(SequenceNumber32 seq, uint32_t size);
+
+  virtual Time
+  AckSeq(SequenceNumber32 ackSeq);
+
+  virtual void
+  TimeoutSeq(SequenceNumber32 seq);
+
+  virtual void
+  ClearSent();
+
+  virtual Ptr<RttEstimator>
+  Copy() const;
+
+  virtual void
+  Reset();
+
+  /**
+   * \brief Number of sequence numbers with history records
+   */
+  size_t
+  GetHistorySize() const;
+
+private:
+  struct Sent {
+    Time time;
+    bool retx;
+  };
+
+  std::unordered_map<uint32_t, Sent> m_sent; ///< \brief send history of outstanding sequences
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_SEQ_MEAN_DEVIATION_H
@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-window.hpp"
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ndn {
+
+static size_t
+RoundUpToPowerOfTwo(uint64_t value)
+{
+  size_t capacity = 1;
+  while (capacity < value) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+const uint64_t SeqWindow::MIN_SPARSE_SPAN;
+const uint64_t SeqWindow::SPARSE_SPAN_FACTOR;
+
+SeqWindow::SeqWindow(size_t initialCapacity)
+  : m_ring(RoundUpToPowerOfTwo(std::max<size_t>(initialCapacity, 1)))
+  , m_mask(m_ring.size() - 1)
+  , m_base(0)
+  , m_end(0)
+  , m_size(0)
+  , m_nArmed(0)
+  , m_isSparse(false)
+{
+}
+
+SeqWindow::Entry&
+SeqWindow::Sent(uint32_t seq, const Time& now)
+{
+  Entry* entry = Find(seq);
+  if (entry == nullptr) {
+    Extend(seq);
+    entry = m_isSparse ? &m_sparse[seq] : &m_ring[seq & m_mask];
+    *entry = Entry();
+    entry->inUse = true;
+    entry->firstSent = now;
+    m_size++;
+  }
+
+  entry->lastSent = now;
+  entry->retxCount++;
+
+  if (!entry->timerArmed) {
+    entry->timerArmed = true;
+    entry->timeoutBase = now;
+    m_nArmed++;
+
+    m_timeouts.push_back(std::make_pair(now, seq));
+    std::push_heap(m_timeouts.begin(), m_timeouts.end(), std::greater<std::pair<Time, uint32_t>>());
+  }
+
+  return *entry;
+}
+
+void
+SeqWindow::Erase(uint32_t seq)
+{
+  Entry* entry = Find(seq);
+  if (entry == nullptr)
+    return;
+
+  if (entry->timerArmed) {
+    m_nArmed--;
+  }
+  if (m_isSparse) {
+    m_sparse.erase(seq);
+  }
+  else {
+    *entry = Entry();
+  }
+  m_size--;
+
+  if (m_size == 0) {
+    // the ring is used again from the next sequence number
+    m_isSparse = false;
+    m_base = m_end;
+    return;
+  }
+  if (m_isSparse) {
+    return;
+  }
+
+  // shrink the covered range down to outstanding sequence numbers
+  while (!m_ring[m_base & m_mask].inUse) {
+    m_base++;
+  }
+  while (!m_ring[(m_end - 1) & m_mask].inUse) {
+    m_end--;
+  }
+}
+
+bool
+SeqWindow::GetEarliestTimeout(Time& start)
+{
+  while (!m_timeouts.empty() && FindPending(m_timeouts.front()) == nullptr) {
+    std::pop_heap(m_timeouts.begin(), m_timeouts.end(), std::greater<std::pair<Time, uint32_t>>());
+    m_timeouts.pop_back();
+  }
+
+  if (m_timeouts.empty())
+    return false;
+
+  start = m_timeouts.front().first;
+  return true;
+}
+
+void
+SeqWindow::Clear()
+{
+  std::fill(m_ring.begin(), m_ring.end(), Entry());
+  m_sparse.clear();
+  m_isSparse = false;
+  m_timeouts.clear();
+  m_base = m_end = 0;
+  m_size = 0;
+  m_nArmed = 0;
+}
+
+void
+SeqWindow::Extend(uint32_t seq)
+{
+  if (m_isSparse) {
+    return;
+  }
+
+  if (m_size == 0) {
+    m_base = seq;
+    m_end = static_cast<uint64_t>(seq) + 1;
+    return;
+  }
+
+  uint64_t base = std::min<uint64_t>(m_base, seq);
+  uint64_t end = std::max<uint64_t>(m_end, static_cast<uint64_t>(seq) + 1);
+  if (end - base > m_ring.size()) {
+    if (end - base > std::max(MIN_SPARSE_SPAN, SPARSE_SPAN_FACTOR * (m_size + 1))) {
+      MakeSparse();
+      return;
+    }
+    Grow(base, end);
+  }
+  // slots in the extended range are free: two sequence numbers share a slot only when they
+  // are at least capacity apart
+  m_base = base;
+  m_end = end;
+}
+
+void
+SeqWindow::Grow(uint64_t base, uint64_t end)
+{
+  std::vector<Entry> ring(RoundUpToPowerOfTwo(end - base));
+  uint64_t mask = ring.size() - 1;
+
+  for (uint64_t seq = m_base; seq < m_end; seq++) {
+    Entry& entry = m_ring[seq & m_mask];
+    if (entry.inUse) {
+      ring[seq & mask] = entry;
+    }
+  }
+
+  NS_ASSERT(ring.size() > m_ring.size());
+  m_ring.swap(ring);
+  m_mask = mask;
+}
+
+void
+SeqWindow::MakeSparse()
+{
+  m_sparse.reserve(m_size + 1);
+  for (uint64_t seq = m_base; seq < m_end; seq++) {
+    Entry& entry = m_ring[seq & m_mask];
+    if (entry.inUse) {
+      m_sparse.emplace(static_cast<uint32_t>(seq), entry);
+      entry = Entry();
+    }
+  }
+  m_isSparse = true;
+}
+
+} // namespace ndn
+} // namespace ns3
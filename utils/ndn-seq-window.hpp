@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEQ_WINDOW_H
+#define NDN_SEQ_WINDOW_H
+
+#include "ns3/nstime.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sliding window of outstanding Interest sequence numbers
+ *
+ * Keeps one record per outstanding sequence number in a ring buffer indexed by the distance
+ * from the lowest outstanding sequence number, and pending retransmission timers in a binary
+ * min-heap ordered by send time.  Once the ring and the heap have grown to the working size of
+ * the consumer, sending an Interest and receiving Data do not allocate memory.
+ *
+ * Sequence numbers do not need to be contiguous, but the ring spans the range between the
+ * lowest and the highest outstanding sequence number.  When that range becomes much larger
+ * than the number of outstanding sequence numbers (e.g., random sequence numbers of
+ * ConsumerZipfMandelbrot), records are kept in a hash map instead until the window is empty
+ * again, so memory stays proportional to the number of outstanding Interests.
+ */
+class SeqWindow {
+public:
+  /**
+   * @brief Record about one outstanding sequence number
+   */
+  struct Entry {
+    Time firstSent;          ///< @brief time when the Interest was sent for the first time
+    Time lastSent;           ///< @brief time when the Interest was sent for the last time
+    Time timeoutBase;        ///< @brief time retransmission timeout is counted from
+    uint32_t retxCount = 0;  ///< @brief number of times the Interest was sent
+    bool inUse = false;      ///< @brief record holds an outstanding sequence number
+    bool timerArmed = false; ///< @brief retransmission timer is pending
+  };
+
+  explicit SeqWindow(size_t initialCapacity = 64);
+
+  /**
+   * @brief Note that Interest for the sequence number is sent
+   *
+   * Creates the record if necessary and (re)arms the retransmission timer, unless the timer is
+   * already pending.
+   */
+  Entry&
+  Sent(uint32_t seq, const Time& now);
+
+  /**
+   * @brief Find record of the outstanding sequence number
+   * @returns nullptr if the sequence number is not outstanding
+   */
+  Entry*
+  Find(uint32_t seq)
+  {
+    if (m_isSparse) {
+      auto entry = m_sparse.find(seq);
+      return entry != m_sparse.end() ? &entry->second : nullptr;
+    }
+
+    if (seq < m_base || seq >= m_end)
+      return nullptr;
+
+    Entry& entry = m_ring[seq & m_mask];
+    return entry.inUse ? &entry : nullptr;
+  }
+
+  /**
+   * @brief Remove record of the sequence number (e.g., when Data is received)
+   */
+  void
+  Erase(uint32_t seq);
+
+  /**
+   * @brief Disarm timers that expired by @p now, in the order of their start times
+   *
+   * @p func is called for each sequence number, after its timer is disarmed
+   */
+  template<class Function>
+  void
+  ExpireTimeouts(const Time& rto, const Time& now, Function func)
+  {
+    while (!m_timeouts.empty() && m_timeouts.front().first + rto <= now) {
+      std::pair<Time, uint32_t> timeout = m_timeouts.front();
+      std::pop_heap(m_timeouts.begin(), m_timeouts.end(), std::greater<std::pair<Time, uint32_t>>());
+      m_timeouts.pop_back();
+
+      // timers are not removed from the heap on Erase, skip stale ones
+      Entry* entry = FindPending(timeout);
+      if (entry == nullptr)
+        continue;
+
+      entry->timerArmed = false;
+      m_nArmed--;
+      func(timeout.second);
+    }
+  }
+
+  /**
+   * @brief Get start time of the earliest pending retransmission timer
+   * @returns false if no timer is pending
+   */
+  bool
+  GetEarliestTimeout(Time& start);
+
+  /**
+   * @brief Number of outstanding sequence numbers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Number of pending retransmission timers
+   */
+  size_t
+  GetArmedCount() const
+  {
+    return m_nArmed;
+  }
+
+  /**
+   * @brief Current capacity of the ring buffer (not used while records are in the hash map)
+   */
+  size_t
+  GetCapacity() const
+  {
+    return m_ring.size();
+  }
+
+  /**
+   * @brief Remove all records and timers, keeping allocated memory
+   */
+  void
+  Clear();
+
+private:
+  Entry*
+  FindPending(const std::pair<Time, uint32_t>& timeout)
+  {
+    Entry* entry = Find(timeout.second);
+    if (entry == nullptr || !entry->timerArmed || entry->timeoutBase != timeout.first)
+      return nullptr;
+    return entry;
+  }
+
+  void
+  Extend(uint32_t seq);
+
+  void
+  Grow(uint64_t base, uint64_t end);
+
+  void
+  MakeSparse();
+
+private:
+  /**
+   * @brief The ring is replaced by the hash map when it would need to span more than
+   *        max(MIN_SPARSE_SPAN, SPARSE_SPAN_FACTOR * number of records) sequence numbers
+   */
+  static const uint64_t MIN_SPARSE_SPAN = 1024;
+  static const uint64_t SPARSE_SPAN_FACTOR = 8;
+
+
+  std::vector<Entry> m_ring;
+  uint64_t m_mask;
+  uint64_t m_base; ///< @brief lowest sequence number covered by the ring
+  uint64_t m_end;  ///< @brief one past the highest sequence number covered by the ring
+  size_t m_size;
+  size_t m_nArmed;
+
+  bool m_isSparse; ///< @brief records are in m_sparse instead of m_ring
+  std::unordered_map<uint32_t, Entry> m_sparse;
+
+  std::vector<std::pair<Time, uint32_t>> m_timeouts; ///< @brief min-heap of (start, seq)
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_WINDOW_H
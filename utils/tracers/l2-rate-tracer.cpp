@@ -18,76 +18,72 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-tracer-registry.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
-#include "ns3/node-list.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
-static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
-  g_tracers;
-
 void
 L2RateTracer::Destroy()
 {
-  g_tracers.clear();
+  ndn::TracerRegistry::Destroy<L2RateTracer>();
 }
 
 void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
-
-    Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
-    trace->SetAveragingPeriod(averagingPeriod);
-    tracers.push_back(trace);
-  }
+  ndn::TracerRegistry::Install<L2RateTracer>(NodeContainer::GetGlobal(), file, averagingPeriod);
+}
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+Ptr<L2RateTracer>
+L2RateTracer::Install(Ptr<Node> node, std::shared_ptr<ndn::TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>(node->GetId()));
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Ptr<L2RateTracer> trace = Create<L2RateTracer>(sink, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+  return trace;
 }
 
-L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+L2RateTracer::L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node)
   : L2Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
+L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L2RateTracer(std::make_shared<ndn::TsvTraceSink>(os, GetSchema(), false), node)
+{
+}
+
+const ndn::TraceSink::Schema&
+L2RateTracer::GetSchema()
+{
+  static const ndn::TraceSink::Schema schema = {
+    {"Time", ndn::TraceSink::COLUMN_DOUBLE},
+    {"Node", ndn::TraceSink::COLUMN_STRING},
+    {"Interface", ndn::TraceSink::COLUMN_STRING},
+    {"Type", ndn::TraceSink::COLUMN_STRING},
+    {"Packets", ndn::TraceSink::COLUMN_DOUBLE},
+    {"Kilobytes", ndn::TraceSink::COLUMN_DOUBLE},
+    {"PacketsRaw", ndn::TraceSink::COLUMN_DOUBLE},
+    {"KilobytesRaw", ndn::TraceSink::COLUMN_DOUBLE}};
+  return schema;
+}
+
 L2RateTracer::~L2RateTracer()
 {
   m_printEvent.Cancel();
@@ -104,7 +100,7 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
@@ -113,23 +109,7 @@ L2RateTracer::PeriodicPrinter()
 void
 L2RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "Interface"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketsRaw"
-     << "\t"
-     << "KilobytesRaw";
+  ndn::TsvTraceSink::PrintHeader(os, GetSchema());
 }
 
 void
@@ -145,17 +125,34 @@ const double alpha = 0.8;
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName, interface)                                                   \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  {                                                                                                \
+    static const std::string type = printName;                                                     \
+    static const std::string interfaceName = interface;                                            \
+    STATS(2).fieldName =                                                                           \
+      /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;   \
+    STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                         \
+                         + /*old value*/ (1 - alpha) * STATS(3).fieldName;                         \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+    sink.AddDouble(time.ToDouble(Time::S));                                                        \
+    sink.AddString(m_node);                                                                        \
+    sink.AddString(interfaceName);                                                                 \
+    sink.AddString(type);                                                                          \
+    sink.AddDouble(STATS(2).fieldName);                                                            \
+    sink.AddDouble(STATS(3).fieldName);                                                            \
+    sink.AddDouble(STATS(0).fieldName);                                                            \
+    sink.AddDouble(STATS(1).fieldName / 1024.0);                                                   \
+    sink.EndRecord();                                                                              \
+  }
 
 void
 L2RateTracer::Print(std::ostream& os) const
+{
+  ndn::TsvTraceSink sink(std::shared_ptr<std::ostream>(&os, std::bind([]{})), GetSchema(), false);
+  Print(sink);
+}
+
+void
+L2RateTracer::Print(ndn::TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
@@ -21,6 +21,7 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -41,13 +42,19 @@ public:
   /**
    * @brief Network layer tracer constructor
    */
+  L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor (records are written as text, without header)
+   */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
   virtual ~L2RateTracer();
 
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see ndn::BinaryTraceSink)
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -60,15 +67,33 @@ public:
   static void
   InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Install tracer on the node, adding records to the sink
+   *
+   * @param node Node on which tracer is installed
+   * @param sink Sink to which records will be added
+   * @param averagingPeriod How often data will be written into the sink
+   */
+  static Ptr<L2RateTracer>
+  Install(Ptr<Node> node, std::shared_ptr<ndn::TraceSink> sink,
+          Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.  Returns after all
+   * buffered records are written to the files.
    */
   static void
   Destroy();
 
+  /**
+   * @brief Columns of the trace
+   */
+  static const ndn::TraceSink::Schema&
+  GetSchema();
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -78,6 +103,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Add records with the current rates to the sink
+   */
+  void
+  Print(ndn::TraceSink& sink) const;
+
   virtual void
   Drop(Ptr<const Packet>);
 
@@ -89,7 +120,7 @@ private:
   Reset();
 
 private:
-  std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-tracer-registry.hpp"
+
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -26,154 +28,188 @@
 
 #include "apps/ndn-app.hpp"
 #include "ns3/simulator.h"
-#include "ns3/node-list.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
-  g_tracers;
+namespace {
 
-void
-AppDelayTracer::Destroy()
-{
-  g_tracers.clear();
-}
+/**
+ * @brief Writes distributions of the tracers in histogram mode every period
+ */
+class HistogramPrinter : public TracerGroup {
+public:
+  HistogramPrinter(shared_ptr<TraceSink> sink, Time period)
+    : TracerGroup(sink)
+    , m_period(period)
+  {
+    m_printEvent = Simulator::Schedule(m_period, &HistogramPrinter::PeriodicPrinter, this);
+  }
 
-void
-AppDelayTracer::InstallAll(const std::string& file)
-{
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  ~HistogramPrinter()
+  {
+    m_printEvent.Cancel();
+  }
 
-    outputStream = os;
+  void
+  Add(Ptr<AppDelayTracer> tracer)
+  {
+    m_tracers.push_back(tracer);
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  void
+  Print()
+  {
+    for (const auto& tracer : m_tracers) {
+      tracer->PrintHistograms(*m_sink);
+    }
   }
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
-    tracers.push_back(trace);
+  virtual void
+  Flush() override
+  {
+    Print(); // incomplete last period
+    TracerGroup::Flush();
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+private:
+  void
+  PeriodicPrinter()
+  {
+    Print();
+    m_printEvent = Simulator::Schedule(m_period, &HistogramPrinter::PeriodicPrinter, this);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
-}
+private:
+  Time m_period;
+  std::list<Ptr<AppDelayTracer>> m_tracers;
+  EventId m_printEvent;
+};
+
+} // namespace
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Destroy()
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  TracerRegistry::Destroy<AppDelayTracer>();
+}
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+void
+AppDelayTracer::InstallAll(const std::string& file)
+{
+  Install(NodeContainer::GetGlobal(), file);
+}
 
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
-    tracers.push_back(trace);
-  }
+void
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+{
+  TracerRegistry::Install<AppDelayTracer>(nodes, file);
+}
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+void
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+{
+  Install(NodeContainer(node), file);
+}
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+void
+AppDelayTracer::InstallAllHistograms(const std::string& file, Time period,
+                                     const std::vector<double>& percentiles)
+{
+  InstallHistograms(NodeContainer::GetGlobal(), file, period, percentiles);
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::InstallHistograms(const NodeContainer& nodes, const std::string& file,
+                                  Time period, const std::vector<double>& percentiles)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  for (double percentile : percentiles) {
+    if (percentile < 0 || percentile > 100) {
+      NS_FATAL_ERROR("Percentile " << percentile << " is not in [0, 100]");
     }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
-  tracers.push_back(trace);
+  shared_ptr<TraceSink> sink = TracerRegistry::Open(file, GetHistogramSchema());
+  if (sink == nullptr) {
+    return;
+  }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  Ptr<HistogramPrinter> printer = Create<HistogramPrinter>(sink, period);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, sink);
+    trace->EnableHistograms(percentiles);
+    printer->Add(trace);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  TracerRegistry::Add<AppDelayTracer>(printer);
 }
 
 Ptr<AppDelayTracer>
 AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, make_shared<TsvTraceSink>(outputStream, GetSchema(), false));
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sink, node);
 
   return trace;
 }
 
+const TraceSink::Schema&
+AppDelayTracer::GetSchema()
+{
+  static const TraceSink::Schema schema = {
+    {"Time", TraceSink::COLUMN_DOUBLE},
+    {"Node", TraceSink::COLUMN_STRING},
+    {"AppId", TraceSink::COLUMN_INTEGER},
+    {"SeqNo", TraceSink::COLUMN_INTEGER},
+    {"Type", TraceSink::COLUMN_STRING},
+    {"DelayS", TraceSink::COLUMN_DOUBLE},
+    {"DelayUS", TraceSink::COLUMN_DOUBLE},
+    {"RetxCount", TraceSink::COLUMN_INTEGER},
+    {"HopCount", TraceSink::COLUMN_INTEGER}};
+  return schema;
+}
+
+const TraceSink::Schema&
+AppDelayTracer::GetHistogramSchema()
+{
+  static const TraceSink::Schema schema = {
+    {"Time", TraceSink::COLUMN_DOUBLE},
+    {"Node", TraceSink::COLUMN_STRING},
+    {"AppId", TraceSink::COLUMN_INTEGER},
+    {"Type", TraceSink::COLUMN_STRING},
+    {"Samples", TraceSink::COLUMN_INTEGER},
+    {"Statistic", TraceSink::COLUMN_STRING},
+    {"DelayS", TraceSink::COLUMN_DOUBLE},
+    {"DelayUS", TraceSink::COLUMN_DOUBLE},
+    {"RetxCount", TraceSink::COLUMN_DOUBLE},
+    {"HopCount", TraceSink::COLUMN_DOUBLE}};
+  return schema;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
+  , m_isHistogramEnabled(false)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -185,9 +221,15 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
+AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : AppDelayTracer(make_shared<TsvTraceSink>(os, GetSchema(), false), node)
+{
+}
+
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(make_shared<TsvTraceSink>(os, GetSchema(), false))
+  , m_isHistogramEnabled(false)
 {
   Connect();
 }
@@ -209,47 +251,129 @@ AppDelayTracer::Connect()
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-     << "Node"
-     << "\t"
-     << "AppId"
-     << "\t"
-     << "SeqNo"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "DelayS"
-     << "\t"
-     << "DelayUS"
-     << "\t"
-     << "RetxCount"
-     << "\t"
-     << "HopCount"
-     << "";
+  TsvTraceSink::PrintHeader(os, GetSchema());
+}
+
+void
+AppDelayTracer::EnableHistograms(const std::vector<double>& percentiles)
+{
+  m_isHistogramEnabled = true;
+  m_percentiles = percentiles;
+
+  m_percentileNames.clear();
+  for (double percentile : percentiles) {
+    std::ostringstream os;
+    os << "p" << percentile;
+    m_percentileNames.push_back(os.str());
+  }
+}
+
+void
+AppDelayTracer::PrintHistograms(TraceSink& sink)
+{
+  static const std::string lastDelay = "LastDelay";
+  static const std::string fullDelay = "FullDelay";
+
+  Time time = Simulator::Now();
+  for (auto& histograms : m_histograms) {
+    PrintDistribution(sink, time, histograms.first, lastDelay, histograms.second.lastDelay);
+    PrintDistribution(sink, time, histograms.first, fullDelay, histograms.second.fullDelay);
+  }
+}
+
+void
+AppDelayTracer::PrintDistribution(TraceSink& sink, const Time& time, uint32_t appId,
+                                  const std::string& type, Distribution& distribution)
+{
+  static const std::string min = "min";
+  static const std::string mean = "mean";
+  static const std::string max = "max";
+
+  uint64_t nSamples = distribution.delay.GetCount();
+  if (nSamples == 0) {
+    return;
+  }
+
+  auto print = [&] (const std::string& statistic, double delayUs, double retxCount,
+                    double hopCount) {
+    sink.AddDouble(time.ToDouble(Time::S));
+    sink.AddString(m_node);
+    sink.AddInteger(appId);
+    sink.AddString(type);
+    sink.AddInteger(nSamples);
+    sink.AddString(statistic);
+    sink.AddDouble(delayUs / 1000000.0);
+    sink.AddDouble(delayUs);
+    sink.AddDouble(retxCount);
+    sink.AddDouble(hopCount);
+    sink.EndRecord();
+  };
+
+  print(min, distribution.delay.GetMin(), distribution.retxCount.GetMin(),
+        distribution.hopCount.GetMin());
+  print(mean, distribution.delay.GetMean(), distribution.retxCount.GetMean(),
+        distribution.hopCount.GetMean());
+  for (size_t i = 0; i < m_percentiles.size(); i++) {
+    print(m_percentileNames[i], distribution.delay.GetPercentile(m_percentiles[i]),
+          distribution.retxCount.GetPercentile(m_percentiles[i]),
+          distribution.hopCount.GetPercentile(m_percentiles[i]));
+  }
+  print(max, distribution.delay.GetMax(), distribution.retxCount.GetMax(),
+        distribution.hopCount.GetMax());
+
+  distribution.delay.Reset();
+  distribution.retxCount.Reset();
+  distribution.hopCount.Reset();
 }
 
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (m_isHistogramEnabled) {
+    Distribution& distribution = m_histograms[app->GetId()].lastDelay;
+    distribution.delay.Record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    distribution.retxCount.Record(1);
+    distribution.hopCount.Record(std::max(hopCount, 0));
+    return;
+  }
+
+  static const std::string type = "LastDelay";
+  m_sink->AddDouble(Simulator::Now().ToDouble(Time::S));
+  m_sink->AddString(m_node);
+  m_sink->AddInteger(app->GetId());
+  m_sink->AddInteger(seqno);
+  m_sink->AddString(type);
+  m_sink->AddDouble(delay.ToDouble(Time::S));
+  m_sink->AddDouble(delay.ToDouble(Time::US));
+  m_sink->AddInteger(1);
+  m_sink->AddInteger(hopCount);
+  m_sink->EndRecord();
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (m_isHistogramEnabled) {
+    Distribution& distribution = m_histograms[app->GetId()].fullDelay;
+    distribution.delay.Record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    distribution.retxCount.Record(retxCount);
+    distribution.hopCount.Record(std::max(hopCount, 0));
+    return;
+  }
+
+  static const std::string type = "FullDelay";
+  m_sink->AddDouble(Simulator::Now().ToDouble(Time::S));
+  m_sink->AddString(m_node);
+  m_sink->AddInteger(app->GetId());
+  m_sink->AddInteger(seqno);
+  m_sink->AddString(type);
+  m_sink->AddDouble(delay.ToDouble(Time::S));
+  m_sink->AddDouble(delay.ToDouble(Time::US));
+  m_sink->AddInteger(retxCount);
+  m_sink->AddInteger(hopCount);
+  m_sink->EndRecord();
 }
 
 } // namespace ndn
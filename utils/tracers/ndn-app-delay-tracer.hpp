@@ -22,6 +22,9 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/ndn-log-linear-histogram.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +33,8 @@
 
 #include <tuple>
 #include <list>
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -49,7 +54,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    *
    */
   static void
@@ -59,7 +65,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    *
    */
   static void
@@ -69,7 +76,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *        second)
    */
@@ -91,18 +99,76 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracer writing into the sink on a specific simulation node
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink);
+
+  /**
+   * @brief Helper method to install tracers writing delay distributions on all simulation nodes
+   *
+   * Instead of a record for every Data, delay (in microseconds), retransmission count and hop
+   * count distributions are collected per application in log-linear histograms (see
+   * LogLinearHistogram), and every period, the minimum, mean, requested percentiles and maximum
+   * of each are written (see GetHistogramSchema).  The incomplete last period is written by
+   * Destroy.
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
+   * @param period How often the distributions are written and reset
+   * @param percentiles Percentiles in [0, 100] to write
+   */
+  static void
+  InstallAllHistograms(const std::string& file, Time period = Seconds(1),
+                       const std::vector<double>& percentiles = {50, 90, 99});
+
+  /**
+   * @brief Helper method to install tracers writing delay distributions on the selected
+   *        simulation nodes
+   *
+   * @see InstallAllHistograms
+   */
+  static void
+  InstallHistograms(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1),
+                    const std::vector<double>& percentiles = {50, 90, 99});
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.  Returns after all
+   * buffered records are written to the files.
    */
   static void
   Destroy();
 
+  /**
+   * @brief Columns of the trace
+   */
+  static const TraceSink::Schema&
+  GetSchema();
+
+  /**
+   * @brief Columns of the trace written in histogram mode
+   *
+   * One record per period, application, type (LastDelay or FullDelay), and statistic ("min",
+   * "mean", "p50", ..., "max"), with the statistic of the delay, retransmission count, and hop
+   * count distributions of the Samples Data packets received in the period.
+   */
+  static const TraceSink::Schema&
+  GetHistogramSchema();
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  sink of the trace records
+   * @param node  pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Trace constructor that attaches to all applications on the node using node's pointer
-   * @param os    reference to the output stream
+   * @param os    reference to the output stream (records are written as text, without header)
    * @param node  pointer to the node
    */
   AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
@@ -127,6 +193,20 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Collect distributions instead of writing a record for every received Data
+   * @param percentiles Percentiles to be written by PrintHistograms
+   */
+  void
+  EnableHistograms(const std::vector<double>& percentiles);
+
+  /**
+   * @brief Add records with the distributions since the last call (in the histogram schema) to
+   *        the sink and reset the distributions
+   */
+  void
+  PrintHistograms(TraceSink& sink);
+
 private:
   void
   Connect();
@@ -138,11 +218,34 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+private:
+  /// @cond include_hidden
+  struct Distribution {
+    LogLinearHistogram delay; ///< @brief microseconds
+    LogLinearHistogram retxCount;
+    LogLinearHistogram hopCount;
+  };
+
+  struct AppHistograms {
+    Distribution lastDelay;
+    Distribution fullDelay;
+  };
+  /// @endcond
+
+  void
+  PrintDistribution(TraceSink& sink, const Time& time, uint32_t appId, const std::string& type,
+                    Distribution& distribution);
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+
+  bool m_isHistogramEnabled;
+  std::vector<double> m_percentiles;
+  std::vector<std::string> m_percentileNames; ///< @brief e.g., "p99"
+  std::map<uint32_t, AppHistograms> m_histograms; ///< @brief app ID => distributions
 };
 
 } // namespace ndn
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-async-output-stream.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AsyncOutputStream");
+
+namespace ns3 {
+namespace ndn {
+
+AsyncOutputStream::AsyncOutputStream(shared_ptr<std::ostream> os, size_t blockSize,
+                                     size_t nBlocks)
+  : std::ostream(nullptr)
+  , m_buffer(os, blockSize, nBlocks)
+{
+  rdbuf(&m_buffer);
+}
+
+AsyncOutputStream::~AsyncOutputStream()
+{
+}
+
+uint64_t
+AsyncOutputStream::GetNStalls() const
+{
+  return m_buffer.GetNStalls();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncOutputStream::Buffer::Buffer(shared_ptr<std::ostream> os, size_t blockSize, size_t nBlocks)
+  : m_os(os)
+  , m_blockSize(std::max<size_t>(blockSize, 1))
+  , m_blocks(std::max<size_t>(nBlocks, 2), std::vector<char>(m_blockSize))
+  , m_nFlushesRequested(0)
+  , m_nFlushesDone(0)
+  , m_nStalls(0)
+  , m_hasFailed(false)
+  , m_isStopping(false)
+{
+  for (auto& block : m_blocks) {
+    m_free.push_back(&block);
+  }
+  m_current = m_free.back();
+  m_free.pop_back();
+  setp(m_current->data(), m_current->data() + m_blockSize);
+
+  m_thread = std::thread(&Buffer::Run, this);
+}
+
+AsyncOutputStream::Buffer::~Buffer()
+{
+  Drain();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_hasWork.notify_one();
+  m_thread.join();
+}
+
+uint64_t
+AsyncOutputStream::Buffer::GetNStalls() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nStalls;
+}
+
+AsyncOutputStream::Buffer::int_type
+AsyncOutputStream::Buffer::overflow(int_type ch)
+{
+  Submit();
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+std::streamsize
+AsyncOutputStream::Buffer::xsputn(const char* s, std::streamsize n)
+{
+  std::streamsize nWritten = 0;
+  while (nWritten < n) {
+    if (pptr() == epptr()) {
+      Submit();
+    }
+    std::streamsize chunk = std::min<std::streamsize>(n - nWritten, epptr() - pptr());
+    std::memcpy(pptr(), s + nWritten, chunk);
+    pbump(static_cast<int>(chunk));
+    nWritten += chunk;
+  }
+  return nWritten;
+}
+
+int
+AsyncOutputStream::Buffer::sync()
+{
+  if (!Drain()) {
+    NS_LOG_ERROR("Output cannot be written");
+    return -1;
+  }
+  return 0;
+}
+
+void
+AsyncOutputStream::Buffer::Submit()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_full.push_back(FullBlock(m_current, pptr() - pbase()));
+  m_hasWork.notify_one();
+
+  if (m_free.empty()) {
+    ++m_nStalls;
+    m_hasFree.wait(lock, [this] { return !m_free.empty(); });
+  }
+  m_current = m_free.back();
+  m_free.pop_back();
+  setp(m_current->data(), m_current->data() + m_blockSize);
+}
+
+bool
+AsyncOutputStream::Buffer::Drain()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (pptr() != pbase()) {
+    m_full.push_back(FullBlock(m_current, pptr() - pbase()));
+    m_current = nullptr;
+  }
+  uint64_t flush = ++m_nFlushesRequested;
+  m_hasWork.notify_one();
+
+  m_hasFree.wait(lock, [this, flush] {
+      return m_nFlushesDone >= flush && m_free.size() == m_blocks.size() - (m_current ? 1 : 0);
+    });
+
+  if (m_current == nullptr) {
+    m_current = m_free.back();
+    m_free.pop_back();
+  }
+  setp(m_current->data(), m_current->data() + m_blockSize);
+  return !m_hasFailed;
+}
+
+void
+AsyncOutputStream::Buffer::Run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_hasWork.wait(lock, [this] {
+        return !m_full.empty() || m_nFlushesDone < m_nFlushesRequested || m_isStopping;
+      });
+
+    if (!m_full.empty()) {
+      FullBlock block = m_full.front();
+      m_full.pop_front();
+
+      lock.unlock();
+      m_os->write(block.first->data(), block.second);
+      bool isGood = m_os->good();
+      lock.lock();
+
+      m_hasFailed = m_hasFailed || !isGood;
+      m_free.push_back(block.first);
+      m_hasFree.notify_one();
+    }
+    else if (m_nFlushesDone < m_nFlushesRequested) {
+      uint64_t flush = m_nFlushesRequested;
+
+      lock.unlock();
+      m_os->flush();
+      bool isGood = m_os->good();
+      lock.lock();
+
+      m_hasFailed = m_hasFailed || !isGood;
+      m_nFlushesDone = flush;
+      m_hasFree.notify_one();
+    }
+    else {
+      break; // stopping, and everything is written
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
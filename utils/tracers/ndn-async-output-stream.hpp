@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ASYNC_OUTPUT_STREAM_H
+#define NDN_ASYNC_OUTPUT_STREAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output stream that writes into another stream from a background thread
+ *
+ * Output is collected into one of a fixed number of memory blocks.  A full block is handed to
+ * the writer thread, which writes it into the underlying stream, and output continues into the
+ * next free block.  The simulation thread therefore touches the file system only when all
+ * blocks are waiting to be written (the disk cannot keep up), in which case it waits for the
+ * writer thread: memory use is bounded by BlockSize x NumBlocks.
+ *
+ * flush() hands over the partially filled block and waits until all blocks are written and the
+ * underlying stream is flushed.  The destructor does the same and stops the writer thread.
+ *
+ * After construction, the underlying stream must not be used until flush() returns.
+ */
+class AsyncOutputStream : public std::ostream {
+public:
+  static const size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+  static const size_t DEFAULT_NUM_BLOCKS = 2;
+
+  /**
+   * @param os underlying stream
+   * @param blockSize size of each block in bytes
+   * @param nBlocks number of blocks (at least 2)
+   */
+  explicit AsyncOutputStream(shared_ptr<std::ostream> os, size_t blockSize = DEFAULT_BLOCK_SIZE,
+                             size_t nBlocks = DEFAULT_NUM_BLOCKS);
+
+  ~AsyncOutputStream();
+
+  /**
+   * @brief Number of times the output waited for the writer thread to free a block
+   */
+  uint64_t
+  GetNStalls() const;
+
+private:
+  /// @cond include_hidden
+  class Buffer : public std::streambuf {
+  public:
+    Buffer(shared_ptr<std::ostream> os, size_t blockSize, size_t nBlocks);
+
+    ~Buffer();
+
+    uint64_t
+    GetNStalls() const;
+
+  protected:
+    virtual int_type
+    overflow(int_type ch);
+
+    virtual std::streamsize
+    xsputn(const char* s, std::streamsize n);
+
+    virtual int
+    sync();
+
+  private:
+    /**
+     * @brief Hand over the current block and continue into a free one
+     */
+    void
+    Submit();
+
+    /**
+     * @brief Hand over the current block and wait until everything is written
+     * @return false if the underlying stream failed
+     */
+    bool
+    Drain();
+
+    void
+    Run();
+
+  private:
+    typedef std::pair<std::vector<char>*, size_t> FullBlock;
+
+    shared_ptr<std::ostream> m_os; ///< @brief used only by the writer thread
+    size_t m_blockSize;
+    std::vector<std::vector<char>> m_blocks;
+    std::vector<char>* m_current;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_hasWork;
+    std::condition_variable m_hasFree;
+    std::deque<FullBlock> m_full;
+    std::vector<std::vector<char>*> m_free;
+    uint64_t m_nFlushesRequested;
+    uint64_t m_nFlushesDone;
+    uint64_t m_nStalls;
+    bool m_hasFailed;
+    bool m_isStopping;
+
+    std::thread m_thread;
+  };
+  /// @endcond
+
+  Buffer m_buffer;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ASYNC_OUTPUT_STREAM_H
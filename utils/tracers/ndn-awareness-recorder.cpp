@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-awareness-recorder.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AwarenessRecorder");
+
+namespace ns3 {
+namespace ndn {
+
+static std::map<std::string, Ptr<AwarenessRecorder>> g_recorders;
+
+Ptr<AwarenessRecorder>
+AwarenessRecorder::Get(const std::string& outputDir)
+{
+  auto recorder = g_recorders.find(outputDir);
+  if (recorder != g_recorders.end())
+    return recorder->second;
+
+  if (g_recorders.empty()) {
+    Simulator::ScheduleDestroy(&AwarenessRecorder::Destroy);
+  }
+
+  Ptr<AwarenessRecorder> newRecorder = Create<AwarenessRecorder>(outputDir);
+  g_recorders[outputDir] = newRecorder;
+  return newRecorder;
+}
+
+void
+AwarenessRecorder::Destroy()
+{
+  for (const auto& recorder : g_recorders) {
+    recorder.second->Write();
+  }
+  g_recorders.clear();
+}
+
+AwarenessRecorder::AwarenessRecorder(const std::string& outputDir)
+  : m_outputDir(outputDir)
+{
+}
+
+void
+AwarenessRecorder::Record(const Name& prefix, uint32_t nodeId, bool isAware,
+                          bool isSafelyInformed, double awarenessTime, int32_t awarenessDistance)
+{
+  NS_LOG_FUNCTION(prefix << nodeId << isAware);
+
+  m_records.push_back({nodeId, prefix, isAware, isSafelyInformed, awarenessTime,
+                       awarenessDistance});
+
+  PrefixStats& stats = m_stats[prefix];
+  stats.nNodes++;
+  if (isAware) {
+    stats.nAware++;
+    stats.awarenessTimeSum += awarenessTime;
+    stats.awarenessDistanceSum += awarenessDistance;
+  }
+  if (isSafelyInformed) {
+    stats.nSafelyInformed++;
+  }
+}
+
+void
+AwarenessRecorder::PrintHeader(std::ostream& os) const
+{
+  os << "Prefix"
+     << "\t"
+     << "Nodes"
+     << "\t"
+     << "AwareNodes"
+     << "\t"
+     << "SafelyInformedNodes"
+     << "\t"
+     << "AvgAwarenessTime"
+     << "\t"
+     << "AvgAwarenessDistance"
+     << "\n";
+}
+
+void
+AwarenessRecorder::Print(std::ostream& os) const
+{
+  for (const auto& prefix : m_stats) {
+    const PrefixStats& stats = prefix.second;
+    double avgTime = stats.nAware > 0 ? stats.awarenessTimeSum / stats.nAware : 0;
+    double avgDistance = stats.nAware > 0 ? 1.0 * stats.awarenessDistanceSum / stats.nAware : 0;
+
+    os << prefix.first << "\t" << stats.nNodes << "\t" << stats.nAware << "\t"
+       << stats.nSafelyInformed << "\t" << avgTime << "\t" << avgDistance << "\n";
+  }
+}
+
+void
+AwarenessRecorder::PrintRecords(std::ostream& os) const
+{
+  for (const NodeRecord& record : m_records) {
+    os << record.nodeId << "  " << record.awarenessDistance << "  " << record.isAware << "  "
+       << record.awarenessTime << "  " << record.isSafelyInformed << "  " << record.prefix
+       << "\n";
+  }
+}
+
+void
+AwarenessRecorder::Write() const
+{
+  if (m_records.empty())
+    return;
+
+  WriteRecords();
+  WriteSummary();
+}
+
+void
+AwarenessRecorder::WriteRecords() const
+{
+  std::string file = m_outputDir + "/awareness-trace.txt";
+
+  // one open and a few large writes, instead of one open/append/close per node
+  std::vector<char> buffer(1 << 20);
+  std::ofstream os;
+  os.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  os.open(file.c_str(), std::ios_base::out | std::ios_base::app);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Awareness trace is lost");
+    return;
+  }
+
+  PrintRecords(os);
+}
+
+void
+AwarenessRecorder::WriteSummary() const
+{
+  std::string file = m_outputDir + "/awareness-summary.txt";
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Awareness summary is lost");
+    return;
+  }
+
+  PrintHeader(os);
+  Print(os);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_AWARENESS_RECORDER_H
+#define NDN_AWARENESS_RECORDER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Collects awareness of critical content (PCD) reported by consumers
+ *
+ * Consumers report awareness of every watched prefix at the end of the simulation.  Reports
+ * are kept in memory and, when the simulator is destroyed (or Destroy is called explicitly),
+ * written in one buffered pass by a single writer per output directory:
+ *
+ * - "awareness-trace.txt" gets one line per node and prefix (appended, as before).  Lines have
+ *   the 5 columns of earlier versions followed by the prefix, so the file should not be shared
+ *   with runs of earlier versions;
+ * - "awareness-summary.txt" gets per-prefix aggregates.
+ */
+class AwarenessRecorder : public SimpleRefCount<AwarenessRecorder> {
+public:
+  /**
+   * @brief Get (create if necessary) recorder writing into the directory
+   */
+  static Ptr<AwarenessRecorder>
+  Get(const std::string& outputDir);
+
+  /**
+   * @brief Write out and remove all recorders
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Record awareness of one node about one watched prefix
+   */
+  void
+  Record(const Name& prefix, uint32_t nodeId, bool isAware, bool isSafelyInformed,
+         double awarenessTime, int32_t awarenessDistance);
+
+  /**
+   * @brief Print head of the summary (e.g., for post-processing)
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print per-prefix summary
+   */
+  void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Print raw per-node records, in the order they were reported
+   */
+  void
+  PrintRecords(std::ostream& os) const;
+
+  /**
+   * @brief Constructor, use Get() instead
+   */
+  explicit AwarenessRecorder(const std::string& outputDir);
+
+private:
+  void
+  Write() const;
+
+  void
+  WriteRecords() const;
+
+  void
+  WriteSummary() const;
+
+private:
+  struct NodeRecord {
+    uint32_t nodeId;
+    Name prefix;
+    bool isAware;
+    bool isSafelyInformed;
+    double awarenessTime;
+    int32_t awarenessDistance;
+  };
+
+  struct PrefixStats {
+    uint32_t nNodes = 0;
+    uint32_t nAware = 0;
+    uint32_t nSafelyInformed = 0;
+    double awarenessTimeSum = 0;
+    int64_t awarenessDistanceSum = 0;
+  };
+
+  std::string m_outputDir;
+  std::vector<NodeRecord> m_records;
+  std::map<Name, PrefixStats> m_stats;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_AWARENESS_RECORDER_H
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-tracer-registry.hpp"
+
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -27,156 +29,79 @@
 #include "apps/ndn-app.hpp"
 #include "model/cs/ndn-content-store.hpp"
 #include "ns3/simulator.h"
-#include "ns3/node-list.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
-
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
-
 void
 CsTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Destroy<CsTracer>();
 }
 
 void
 CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod);
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  TracerRegistry::Install<CsTracer>(nodes, file, averagingPeriod);
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer(node), file, averagingPeriod);
 }
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TsvTraceSink>(outputStream, GetSchema(), false),
+                 averagingPeriod);
+}
+
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
+const TraceSink::Schema&
+CsTracer::GetSchema()
+{
+  static const TraceSink::Schema schema = {
+    {"Time", TraceSink::COLUMN_DOUBLE},
+    {"Node", TraceSink::COLUMN_STRING},
+    {"Type", TraceSink::COLUMN_STRING},
+    {"Packets", TraceSink::COLUMN_DOUBLE}};
+  return schema;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,9 +113,14 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
+CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : CsTracer(make_shared<TsvTraceSink>(os, GetSchema(), false), node)
+{
+}
+
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(make_shared<TsvTraceSink>(os, GetSchema(), false))
 {
   Connect();
 }
@@ -218,7 +148,7 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -227,16 +157,7 @@ CsTracer::PeriodicPrinter()
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t";
+  TsvTraceSink::PrintHeader(os, GetSchema());
 }
 
 void
@@ -246,11 +167,24 @@ CsTracer::Reset()
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  {                                                                                                \
+    static const std::string type = printName;                                                     \
+    sink.AddDouble(time.ToDouble(Time::S));                                                        \
+    sink.AddString(m_node);                                                                        \
+    sink.AddString(type);                                                                          \
+    sink.AddDouble(m_stats.fieldName);                                                             \
+    sink.EndRecord();                                                                              \
+  }
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  TsvTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})), GetSchema(), false);
+  Print(sink);
+}
+
+void
+CsTracer::Print(TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
@@ -22,6 +22,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-sink.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -64,7 +66,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -80,7 +83,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -96,7 +100,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -124,18 +129,38 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracer writing into the sink on a specific simulation node
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.  Returns after all
+   * buffered records are written to the files.
    */
   static void
   Destroy();
 
+  /**
+   * @brief Columns of the trace
+   */
+  static const TraceSink::Schema&
+  GetSchema();
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
-   * @param os    reference to the output stream
+   * @param sink  sink of the trace records
+   * @param node  pointer to the node
+   */
+  CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param os    reference to the output stream (records are written as text, without header)
    * @param node  pointer to the node
    */
   CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
@@ -168,6 +193,12 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Add records with the current statistics to the sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 private:
   void
   Connect();
@@ -192,7 +223,7 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 
   Time m_period;
   EventId m_printEvent;
@@ -18,164 +18,393 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-tracer-registry.hpp"
+
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
-#include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include "daemon/fw/forwarder.hpp"
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
+namespace {
 
-void
-L3RateTracer::Destroy()
-{
-  g_tracers.clear();
-}
+/**
+ * @brief Collects per-node totals of every record type, to be aggregated across the nodes
+ */
+class NodeAggregator : public TraceSink {
+public:
+  explicit NodeAggregator(size_t nNodes)
+    : TraceSink(L3RateTracer::GetSchema())
+    , m_nNodes(nNodes)
+    , m_node(0)
+    , m_field(0)
+    , m_values()
+  {
+  }
 
-void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
-{
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  void
+  SetNode(size_t node)
+  {
+    m_node = node;
+  }
+
+  virtual void
+  AddDouble(double value)
+  {
+    if (m_field >= FIRST_VALUE) {
+      m_values[m_field - FIRST_VALUE] = value;
     }
+    m_field++;
+  }
 
-    outputStream = os;
+  virtual void
+  AddInteger(int64_t value)
+  {
+    m_field++;
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  virtual void
+  AddString(const std::string& value)
+  {
+    if (m_field == TYPE) {
+      m_type = value;
+    }
+    m_field++;
   }
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+  virtual void
+  EndRecord()
+  {
+    NS_ASSERT(m_field == m_schema.size());
+    m_field = 0;
+
+    auto type = m_typeIndex.find(m_type);
+    if (type == m_typeIndex.end()) {
+      type = m_typeIndex.insert(std::make_pair(m_type, m_types.size())).first;
+      m_types.push_back(m_type);
+      m_totals.push_back(std::vector<Values>(m_nNodes, Values()));
+    }
+
+    Values& totals = m_totals[type->second][m_node];
+    for (size_t i = 0; i < N_VALUES; i++) {
+      totals[i] += m_values[i];
+    }
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  virtual void
+  Flush()
+  {
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
-}
+  /**
+   * @brief Add sum and percentiles across the nodes of every record type to the sink
+   */
+  void
+  Print(TraceSink& sink, const Time& time, const std::vector<double>& percentiles)
+  {
+    static const std::string sum = "sum";
+    static const std::string all = "all";
+
+    std::vector<std::string> labels;
+    for (double percentile : percentiles) {
+      std::ostringstream os;
+      os << "p" << percentile;
+      labels.push_back(os.str());
+    }
 
-void
-L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
-{
-  using namespace boost;
-  using namespace std;
+    std::vector<double> values(m_nNodes);
+    for (size_t type = 0; type < m_types.size(); type++) {
+      std::vector<Values>& totals = m_totals[type];
+
+      Values sums = Values();
+      for (const Values& nodeTotals : totals) {
+        for (size_t i = 0; i < N_VALUES; i++) {
+          sums[i] += nodeTotals[i];
+        }
+      }
+      PrintRecord(sink, time, sum, all, m_types[type], sums);
+
+      // nearest-rank percentiles of each value
+      std::vector<Values> ranked(percentiles.size());
+      for (size_t i = 0; i < N_VALUES; i++) {
+        for (size_t node = 0; node < m_nNodes; node++) {
+          values[node] = totals[node][i];
+        }
+        std::sort(values.begin(), values.end());
+        for (size_t j = 0; j < percentiles.size(); j++) {
+          size_t rank = static_cast<size_t>(std::ceil(percentiles[j] / 100.0 * m_nNodes));
+          ranked[j][i] = values[std::min(std::max<size_t>(rank, 1), m_nNodes) - 1];
+        }
+      }
+      for (size_t j = 0; j < percentiles.size(); j++) {
+        PrintRecord(sink, time, labels[j], all, m_types[type], ranked[j]);
+      }
+    }
+  }
 
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+private:
+  static const size_t TYPE = 4;        ///< @brief column of the record type
+  static const size_t FIRST_VALUE = 5; ///< @brief first of the Packets...KilobytesRaw columns
+  static const size_t N_VALUES = 4;
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  typedef std::array<double, N_VALUES> Values;
+
+  static void
+  PrintRecord(TraceSink& sink, const Time& time, const std::string& node,
+              const std::string& face, const std::string& type, const Values& values)
+  {
+    sink.AddDouble(time.ToDouble(Time::S));
+    sink.AddString(node);
+    sink.AddInteger(-1);
+    sink.AddString(face);
+    sink.AddString(type);
+    for (double value : values) {
+      sink.AddDouble(value);
     }
+    sink.EndRecord();
+  }
+
+private:
+  size_t m_nNodes;
+  size_t m_node;
+  size_t m_field;
+  std::string m_type;
+  Values m_values;
+
+  std::vector<std::string> m_types; ///< @brief in the order of appearance
+  std::unordered_map<std::string, size_t> m_typeIndex;
+  std::vector<std::vector<Values>> m_totals; ///< @brief [type][node]
+};
+
+} // namespace
 
-    outputStream = os;
+/**
+ * @brief Tracers writing into the same sink, printed by a single timer
+ */
+class L3RateTracerGroup : public TracerGroup {
+public:
+  L3RateTracerGroup(shared_ptr<TraceSink> sink, Time period, bool isAggregated,
+                    const std::vector<double>& percentiles)
+    : TracerGroup(sink)
+    , m_period(period)
+    , m_isAggregated(isAggregated)
+    , m_percentiles(percentiles)
+    , m_created(Simulator::Now())
+  {
+    m_printEvent = Simulator::Schedule(m_period, &L3RateTracerGroup::PeriodicPrinter, this);
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  ~L3RateTracerGroup()
+  {
+    m_printEvent.Cancel();
   }
 
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+  /**
+   * @brief Whether tracers installed now with the settings can join the group
+   *
+   * Aggregated groups cover the nodes of one InstallAggregated call.  Tracers that join later
+   * than the group was created would report rates over a partial first period.
+   */
+  bool
+  CanJoin(Time period, bool isAggregated) const
+  {
+    return !m_isAggregated && !isAggregated && period == m_period
+           && Simulator::Now() == m_created;
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  void
+  Install(const NodeContainer& nodes)
+  {
+    for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+      NS_LOG_DEBUG("Node: " << (*node)->GetId());
+
+      Ptr<L3RateTracer> tracer = Create<L3RateTracer>(m_sink, *node);
+      // printed by the group
+      tracer->m_printEvent.Cancel();
+      tracer->m_period = m_period;
+      m_tracers.push_back(tracer);
+    }
+
+    std::stable_sort(m_tracers.begin(), m_tracers.end(),
+                     [] (const Ptr<L3RateTracer>& a, const Ptr<L3RateTracer>& b) {
+                       return a->m_nodePtr->GetId() < b->m_nodePtr->GetId();
+                     });
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
-}
+private:
+  void
+  PeriodicPrinter()
+  {
+    if (!m_isAggregated) {
+      for (const auto& tracer : m_tracers) {
+        tracer->Print(*m_sink);
+        tracer->Reset();
+      }
+    }
+    else {
+      NodeAggregator aggregator(m_tracers.size());
+      for (size_t i = 0; i < m_tracers.size(); i++) {
+        aggregator.SetNode(i);
+        m_tracers[i]->Print(aggregator);
+        m_tracers[i]->Reset();
+      }
+      aggregator.Print(*m_sink, Simulator::Now(), m_percentiles);
+    }
 
-void
-L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
-{
-  using namespace boost;
-  using namespace std;
+    m_printEvent = Simulator::Schedule(m_period, &L3RateTracerGroup::PeriodicPrinter, this);
+  }
 
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+private:
+  Time m_period;
+  bool m_isAggregated;
+  std::vector<double> m_percentiles;
+  Time m_created;
+  EventId m_printEvent;
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  std::vector<Ptr<L3RateTracer>> m_tracers; ///< @brief ordered by node ID
+};
 
-    outputStream = os;
+static void
+InstallGroup(const NodeContainer& nodes, const std::string& file, Time averagingPeriod,
+             bool isAggregated, const std::vector<double>& percentiles)
+{
+  shared_ptr<TraceSink> sink = TracerRegistry::Open(file, L3RateTracer::GetSchema());
+  if (sink == nullptr) {
+    return;
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+
+  // tracers installed into a shared file are printed by the timer of its group
+  for (Ptr<TracerGroup> existing : TracerRegistry::Find<L3RateTracer>(sink)) {
+    Ptr<L3RateTracerGroup> group = StaticCast<L3RateTracerGroup>(existing);
+    if (group->CanJoin(averagingPeriod, isAggregated)) {
+      group->Install(nodes);
+      return;
+    }
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
+  Ptr<L3RateTracerGroup> group =
+    Create<L3RateTracerGroup>(sink, averagingPeriod, isAggregated, percentiles);
+  group->Install(nodes);
+  TracerRegistry::Add<L3RateTracer>(group);
+}
+
+void
+L3RateTracer::Destroy()
+{
+  TracerRegistry::Destroy<L3RateTracer>();
+}
+
+void
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  InstallGroup(NodeContainer::GetGlobal(), file, averagingPeriod, false, {});
+}
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+void
+L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  InstallGroup(nodes, file, averagingPeriod, false, {});
+}
+
+void
+L3RateTracer::Install(Ptr<Node> node, const std::string& file,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  InstallGroup(NodeContainer(node), file, averagingPeriod, false, {});
+}
+
+void
+L3RateTracer::InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                                Time averagingPeriod, const std::vector<double>& percentiles)
+{
+  for (double percentile : percentiles) {
+    if (percentile < 0 || percentile > 100) {
+      NS_FATAL_ERROR("Percentile " << percentile << " is not in [0, 100]");
+    }
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  InstallGroup(nodes, file, averagingPeriod, true, percentiles);
 }
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TsvTraceSink>(outputStream, GetSchema(), false),
+                 averagingPeriod);
+}
+
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
-L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+const TraceSink::Schema&
+L3RateTracer::GetSchema()
+{
+  static const TraceSink::Schema schema = {
+    {"Time", TraceSink::COLUMN_DOUBLE},
+    {"Node", TraceSink::COLUMN_STRING},
+    {"FaceId", TraceSink::COLUMN_INTEGER},
+    {"FaceDescr", TraceSink::COLUMN_STRING},
+    {"Type", TraceSink::COLUMN_STRING},
+    {"Packets", TraceSink::COLUMN_DOUBLE},
+    {"Kilobytes", TraceSink::COLUMN_DOUBLE},
+    {"PacketRaw", TraceSink::COLUMN_DOUBLE},
+    {"KilobytesRaw", TraceSink::COLUMN_DOUBLE}};
+  return schema;
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
+  , m_allFaces(nfd::face::INVALID_FACEID, "all")
 {
   SetAveragingPeriod(Seconds(1.0));
+
+  // face descriptions are resolved once, when faces are added
+  nfd::FaceTable& faceTable = node->GetObject<L3Protocol>()->getForwarder()->getFaceTable();
+  for (const Face& face : faceTable) {
+    AddFace(face);
+  }
+  m_afterAddFace = faceTable.afterAdd.connect([this] (const Face& face) { AddFace(face); });
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L3RateTracer(make_shared<TsvTraceSink>(os, GetSchema(), false), node)
+{
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(make_shared<TsvTraceSink>(os, GetSchema(), false))
+  , m_allFaces(nfd::face::INVALID_FACEID, "all")
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -196,7 +425,7 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -205,68 +434,68 @@ L3RateTracer::PeriodicPrinter()
 void
 L3RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  TsvTraceSink::PrintHeader(os, GetSchema());
 }
 
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (auto& stats : m_faces) {
+    stats.packets.Reset();
+    stats.bytes.Reset();
   }
+  m_allFaces.packets.Reset();
+  m_allFaces.bytes.Reset();
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
+#define RATE(statsName, fieldName) stats.statsName.fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  {                                                                                                \
+    static const std::string type = printName;                                                     \
+    stats.packetRate.fieldName = /*new value*/ alpha * RATE(packets, fieldName)                    \
+                                 + /*old value*/ (1 - alpha) * stats.packetRate.fieldName;         \
+    stats.kilobyteRate.fieldName = /*new value*/ alpha * RATE(bytes, fieldName) / 1024.0           \
+                                   + /*old value*/ (1 - alpha) * stats.kilobyteRate.fieldName;     \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+    sink.AddDouble(time.ToDouble(Time::S));                                                        \
+    sink.AddString(m_node);                                                                        \
+    if (stats.faceId != nfd::face::INVALID_FACEID) {                                               \
+      sink.AddInteger(stats.faceId);                                                               \
+    }                                                                                              \
+    else {                                                                                         \
+      sink.AddInteger(-1);                                                                         \
+    }                                                                                              \
+    sink.AddString(stats.faceDescr);                                                               \
+    sink.AddString(type);                                                                          \
+    sink.AddDouble(stats.packetRate.fieldName);                                                    \
+    sink.AddDouble(stats.kilobyteRate.fieldName);                                                  \
+    sink.AddDouble(stats.packets.fieldName);                                                       \
+    sink.AddDouble(stats.bytes.fieldName / 1024.0);                                                \
+    sink.EndRecord();                                                                              \
+  }
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  TsvTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})), GetSchema(), false);
+  Print(sink);
+}
+
+void
+L3RateTracer::Print(TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  // in the order of FaceId
+  for (uint32_t index : m_faceIndex) {
+    if (index == 0 || !m_faces[index - 1].isUsed)
       continue;
 
+    FaceStats& stats = m_faces[index - 1];
+
     PRINTER("InInterests", m_inInterests);
     PRINTER("OutInterests", m_outInterests);
 
@@ -283,122 +512,134 @@ L3RateTracer::Print(std::ostream& os) const
     PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (m_allFaces.isUsed) {
+    FaceStats& stats = m_allFaces;
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
   }
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    stats.bytes.m_outData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    stats.bytes.m_inData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_outNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_outNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetFaceStats(face);
+  stats.packets.m_inNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_inNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  m_allFaces.isUsed = true;
+  m_allFaces.packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    GetFaceStats(in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    GetFaceStats(out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  m_allFaces.isUsed = true;
+  m_allFaces.packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    GetFaceStats(in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    GetFaceStats(out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
-void
-L3RateTracer::AddInfo(const Face& face)
+L3RateTracer::FaceStats&
+L3RateTracer::GetFaceStats(const Face& face)
 {
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  nfd::FaceId faceId = face.getId();
+  if (faceId < m_faceIndex.size() && m_faceIndex[faceId] != 0) {
+    FaceStats& stats = m_faces[m_faceIndex[faceId] - 1];
+    stats.isUsed = true;
+    return stats;
+  }
+
+  // face added before the tracer could see it
+  FaceStats& stats = AddFace(face);
+  stats.isUsed = true;
+  return stats;
+}
+
+L3RateTracer::FaceStats&
+L3RateTracer::AddFace(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  if (faceId >= m_faceIndex.size()) {
+    m_faceIndex.resize(faceId + 1, 0);
+  }
+
+  if (m_faceIndex[faceId] == 0) {
+    m_faces.push_back(FaceStats(faceId, boost::lexical_cast<std::string>(face.getLocalUri())));
+    m_faceIndex[faceId] = m_faces.size();
   }
+  return m_faces[m_faceIndex[faceId] - 1];
 }
 
 } // namespace ndn
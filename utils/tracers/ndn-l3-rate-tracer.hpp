@@ -23,28 +23,37 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
-#include <map>
+#include <ndn-cxx/util/signal.hpp>
+
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class L3RateTracerGroup;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Tracers installed into the same file at the same time with the same averaging period form a
+ * group, which has a single timer: every averaging period, the records of all nodes of the group
+ * are written in one pass, ordered by node ID.  Each InstallAggregated call forms its own group.
  */
 class L3RateTracer : public L3Tracer {
 public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -56,7 +65,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -67,25 +77,61 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
   static void
   Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes, writing only
+   *        statistics across the nodes
+   *
+   * Every averaging period, the values of each record type are summed over the faces of every
+   * node, and the per-node totals are aggregated into their sum and the requested percentiles
+   * across the nodes.  The Node column of the records is "sum" or the percentile (e.g., "p90",
+   * where "p100" is the maximum), and the face is -1 ("all").  All nodes are included, also the
+   * ones without any traffic.
+   *
+   * @param nodes Nodes on which to install tracer (e.g., NodeContainer::GetGlobal())
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
+   * @param averagingPeriod How often data will be written into the trace file
+   * @param percentiles Percentiles in [0, 100] to write in addition to the sum
+   */
+  static void
+  InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                    Time averagingPeriod = Seconds(0.5),
+                    const std::vector<double>& percentiles = {50, 90, 99, 100});
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.  Returns after all
+   * buffered records are written to the files.
    */
   static void
   Destroy();
 
+  /**
+   * @brief Columns of the trace
+   */
+  static const TraceSink::Schema&
+  GetSchema();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the trace records
+   * @param node  pointer to the node
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
-   * @param os    reference to the output stream
+   * @param os    reference to the output stream (records are written as text, without header)
    * @param node  pointer to the node
    */
   L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
@@ -118,6 +164,12 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracer writing into the sink on a specific simulation node
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +177,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Add records with the current rates to the sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -152,6 +210,8 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  friend class L3RateTracerGroup;
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -161,16 +221,51 @@ private:
   void
   Reset();
 
-  void
-  AddInfo(const Face& face);
+  /// @cond include_hidden
+  struct FaceStats {
+    FaceStats(nfd::FaceId faceId, const std::string& faceDescr)
+      : faceId(faceId)
+      , faceDescr(faceDescr)
+      , isUsed(false)
+      , packets()
+      , bytes()
+      , packetRate()
+      , kilobyteRate()
+    {
+    }
+
+    nfd::FaceId faceId;
+    std::string faceDescr; ///< @brief kept, because the face may no longer exist when printing
+    bool isUsed;           ///< @brief only faces with traced packets are printed
+
+    Stats packets;      ///< @brief counts in the current period
+    Stats bytes;        ///< @brief sizes in the current period
+    Stats packetRate;   ///< @brief averaged packets per second
+    Stats kilobyteRate; ///< @brief averaged kilobytes per second
+  };
+  /// @endcond
+
+  /**
+   * @brief Get stats of the face, which are created when the face is added to the node
+   */
+  FaceStats&
+  GetFaceStats(const Face& face);
+
+  /**
+   * @brief Create stats for the face, resolving its description
+   */
+  FaceStats&
+  AddFace(const Face& face);
 
 private:
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  mutable std::vector<FaceStats> m_faces; ///< @brief indexed by local face index
+  std::vector<uint32_t> m_faceIndex;      ///< @brief FaceId => local face index + 1 (0 if none)
+  mutable FaceStats m_allFaces;           ///< @brief Interests satisfied or timed out on the node
+  ::ndn::util::signal::ScopedConnection m_afterAddFace;
 };
 
 } // namespace ndn
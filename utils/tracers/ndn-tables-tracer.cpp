@@ -0,0 +1,291 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tables-tracer.hpp"
+#include "ndn-tracer-registry.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/fw/strategy-info.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TablesTracer");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Time the PIT entry was first seen by the tracer, kept in the entry
+ */
+class PitEntryCreation : public nfd::fw::StrategyInfo {
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 9050;
+  }
+
+  explicit
+  PitEntryCreation(const Time& time)
+    : time(time)
+    , isRecorded(false)
+  {
+  }
+
+public:
+  Time time;
+  bool isRecorded; ///< @brief a satisfied entry can be satisfied again while it lingers
+};
+
+} // namespace
+
+void
+TablesTracer::Destroy()
+{
+  TracerRegistry::Destroy<TablesTracer>();
+}
+
+void
+TablesTracer::InstallAll(const std::string& file, Time period, bool isPitLifetimeEnabled)
+{
+  Install(NodeContainer::GetGlobal(), file, period, isPitLifetimeEnabled);
+}
+
+void
+TablesTracer::Install(const NodeContainer& nodes, const std::string& file, Time period,
+                      bool isPitLifetimeEnabled)
+{
+  TracerRegistry::Install<TablesTracer>(nodes, file, period, isPitLifetimeEnabled);
+}
+
+void
+TablesTracer::Install(Ptr<Node> node, const std::string& file, Time period,
+                      bool isPitLifetimeEnabled)
+{
+  Install(NodeContainer(node), file, period, isPitLifetimeEnabled);
+}
+
+Ptr<TablesTracer>
+TablesTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time period,
+                      bool isPitLifetimeEnabled)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<TablesTracer> trace = Create<TablesTracer>(sink, node);
+  trace->SetPeriod(period);
+  if (isPitLifetimeEnabled) {
+    trace->EnablePitLifetimes();
+  }
+
+  return trace;
+}
+
+const TraceSink::Schema&
+TablesTracer::GetSchema()
+{
+  static const TraceSink::Schema schema = {
+    {"Time", TraceSink::COLUMN_DOUBLE},
+    {"Node", TraceSink::COLUMN_STRING},
+    {"Type", TraceSink::COLUMN_STRING},
+    {"Statistic", TraceSink::COLUMN_STRING},
+    {"Value", TraceSink::COLUMN_DOUBLE}};
+  return schema;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+TablesTracer::TablesTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_l3(node->GetObject<L3Protocol>())
+  , m_cs(node->GetObject<ContentStore>())
+  , m_sink(sink)
+  , m_isPitLifetimeEnabled(false)
+{
+  NS_ASSERT_MSG(m_l3 != nullptr, "Ndn stack should be installed on the node " << node->GetId());
+
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+TablesTracer::~TablesTracer()
+{
+  m_printEvent.Cancel();
+
+  if (m_isPitLifetimeEnabled) {
+    m_l3->TraceDisconnectWithoutContext("InInterests",
+                                        MakeCallback(&TablesTracer::InInterests, this));
+    m_l3->TraceDisconnectWithoutContext("SatisfiedInterests",
+                                        MakeCallback(&TablesTracer::SatisfiedInterests, this));
+    m_l3->TraceDisconnectWithoutContext("TimedOutInterests",
+                                        MakeCallback(&TablesTracer::TimedOutInterests, this));
+  }
+}
+
+void
+TablesTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &TablesTracer::PeriodicPrinter, this);
+}
+
+void
+TablesTracer::EnablePitLifetimes()
+{
+  if (m_isPitLifetimeEnabled) {
+    return;
+  }
+  m_isPitLifetimeEnabled = true;
+
+  m_l3->TraceConnectWithoutContext("InInterests", MakeCallback(&TablesTracer::InInterests, this));
+  m_l3->TraceConnectWithoutContext("SatisfiedInterests",
+                                   MakeCallback(&TablesTracer::SatisfiedInterests, this));
+  m_l3->TraceConnectWithoutContext("TimedOutInterests",
+                                   MakeCallback(&TablesTracer::TimedOutInterests, this));
+}
+
+void
+TablesTracer::PeriodicPrinter()
+{
+  Print(*m_sink);
+
+  m_printEvent = Simulator::Schedule(m_period, &TablesTracer::PeriodicPrinter, this);
+}
+
+void
+TablesTracer::Print(TraceSink& sink)
+{
+  static const std::string pit = "PitEntries";
+  static const std::string fib = "FibEntries";
+  static const std::string measurements = "MeasurementsEntries";
+  static const std::string cs = "CsEntries";
+  static const std::string size = "size";
+  static const std::string satisfied = "SatisfiedPitLifetime";
+  static const std::string timedOut = "TimedOutPitLifetime";
+
+  Time time = Simulator::Now();
+  nfd::Forwarder& forwarder = *m_l3->getForwarder();
+
+  PrintRecord(sink, time, pit, size, forwarder.getPit().size());
+  PrintRecord(sink, time, fib, size, forwarder.getFib().size());
+  PrintRecord(sink, time, measurements, size, forwarder.getMeasurements().size());
+  PrintRecord(sink, time, cs, size,
+              m_cs != nullptr ? m_cs->GetSize() : forwarder.getCs().size());
+
+  if (m_isPitLifetimeEnabled) {
+    PrintLifetimes(sink, time, satisfied, m_satisfiedLifetimes);
+    PrintLifetimes(sink, time, timedOut, m_timedOutLifetimes);
+  }
+}
+
+void
+TablesTracer::PrintRecord(TraceSink& sink, const Time& time, const std::string& type,
+                          const std::string& statistic, double value) const
+{
+  sink.AddDouble(time.ToDouble(Time::S));
+  sink.AddString(m_node);
+  sink.AddString(type);
+  sink.AddString(statistic);
+  sink.AddDouble(value);
+  sink.EndRecord();
+}
+
+void
+TablesTracer::PrintLifetimes(TraceSink& sink, const Time& time, const std::string& type,
+                             LogLinearHistogram& lifetimes)
+{
+  static const std::string count = "count";
+  static const std::string min = "min";
+  static const std::string mean = "mean";
+  static const std::string max = "max";
+  static const std::vector<std::pair<std::string, double>> percentiles = {
+    {"p50", 50}, {"p90", 90}, {"p99", 99}};
+
+  PrintRecord(sink, time, type, count, lifetimes.GetCount());
+  if (lifetimes.GetCount() == 0) {
+    return;
+  }
+
+  PrintRecord(sink, time, type, min, lifetimes.GetMin() / 1000000.0);
+  PrintRecord(sink, time, type, mean, lifetimes.GetMean() / 1000000.0);
+  for (const auto& percentile : percentiles) {
+    PrintRecord(sink, time, type, percentile.first,
+                lifetimes.GetPercentile(percentile.second) / 1000000.0);
+  }
+  PrintRecord(sink, time, type, max, lifetimes.GetMax() / 1000000.0);
+
+  lifetimes.Reset();
+}
+
+void
+TablesTracer::InInterests(const Interest& interest, const Face&)
+{
+  // the forwarder has already processed the Interest, so its PIT entry exists (if any)
+  shared_ptr<nfd::pit::Entry> entry = m_l3->getForwarder()->getPit().find(interest);
+  if (entry == nullptr || entry->isSatisfied) {
+    return;
+  }
+
+  entry->insertStrategyInfo<PitEntryCreation>(Simulator::Now());
+}
+
+void
+TablesTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
+{
+  RecordLifetime(entry, m_satisfiedLifetimes);
+}
+
+void
+TablesTracer::TimedOutInterests(const nfd::pit::Entry& entry)
+{
+  RecordLifetime(entry, m_timedOutLifetimes);
+}
+
+void
+TablesTracer::RecordLifetime(const nfd::pit::Entry& entry, LogLinearHistogram& lifetimes)
+{
+  PitEntryCreation* creation = entry.getStrategyInfo<PitEntryCreation>();
+  if (creation == nullptr || creation->isRecorded) {
+    return; // created before the tracer was installed
+  }
+
+  creation->isRecorded = true;
+  lifetimes.Record((Simulator::Now() - creation->time).GetMicroSeconds());
+}
+
+} // namespace ndn
+} // namespace ns3
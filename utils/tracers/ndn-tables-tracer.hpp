@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TABLES_TRACER_H
+#define NDN_TABLES_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
+
+#include "ndn-trace-sink.hpp"
+#include "../ndn-log-linear-histogram.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class L3Protocol;
+class ContentStore;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN tracer for occupancy of the forwarding tables (PIT, FIB, measurements and CS)
+ *
+ * Every period, the number of entries in each table of the node is written.  Optionally, the
+ * distribution of lifetimes of PIT entries removed within the period (satisfied or timed out) is
+ * written as well.  Lifetimes are recorded when entries are removed, so the cost does not depend
+ * on the size of the PIT.  Only entries of the packets reported by the trace sources of
+ * L3Protocol are included (see TraceFilter).
+ */
+class TablesTracer : public SimpleRefCount<TablesTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *        Files ending with .bin get the binary columnar format (see BinaryTraceSink)
+   * @param period How often table sizes are written into the trace file
+   * @param isPitLifetimeEnabled Whether to write distribution of PIT entry lifetimes
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1),
+             bool isPitLifetimeEnabled = false);
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @see InstallAll
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1),
+          bool isPitLifetimeEnabled = false);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @see InstallAll
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file, Time period = Seconds(1),
+          bool isPitLifetimeEnabled = false);
+
+  /**
+   * @brief Helper method to install tracer writing into the sink on a specific simulation node
+   */
+  static Ptr<TablesTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time period = Seconds(1),
+          bool isPitLifetimeEnabled = false);
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * Returns after all buffered records are written to the files.
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Columns of the trace
+   */
+  static const TraceSink::Schema&
+  GetSchema();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the trace records
+   * @param node  pointer to the node (with NDN stack)
+   */
+  TablesTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  ~TablesTracer();
+
+  void
+  SetPeriod(const Time& period);
+
+  /**
+   * @brief Start recording lifetimes of PIT entries (written with percentiles 50, 90 and 99)
+   */
+  void
+  EnablePitLifetimes();
+
+  /**
+   * @brief Add records with the current table sizes (and the lifetimes since the last call)
+   */
+  void
+  Print(TraceSink& sink);
+
+private:
+  void
+  PeriodicPrinter();
+
+  void
+  PrintRecord(TraceSink& sink, const Time& time, const std::string& type,
+              const std::string& statistic, double value) const;
+
+  void
+  PrintLifetimes(TraceSink& sink, const Time& time, const std::string& type,
+                 LogLinearHistogram& lifetimes);
+
+  void
+  InInterests(const Interest& interest, const Face&);
+
+  void
+  SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&);
+
+  void
+  TimedOutInterests(const nfd::pit::Entry& entry);
+
+  void
+  RecordLifetime(const nfd::pit::Entry& entry, LogLinearHistogram& lifetimes);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+  Ptr<L3Protocol> m_l3;
+  Ptr<ContentStore> m_cs; ///< @brief ndnSIM content store (if used instead of the NFD one)
+
+  shared_ptr<TraceSink> m_sink;
+  Time m_period;
+  EventId m_printEvent;
+
+  bool m_isPitLifetimeEnabled;
+  LogLinearHistogram m_satisfiedLifetimes; ///< @brief microseconds
+  LogLinearHistogram m_timedOutLifetimes;  ///< @brief microseconds
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TABLES_TRACER_H
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-filter.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include "ns3/node.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceFilter");
+
+namespace ns3 {
+namespace ndn {
+
+TraceFilter::TraceFilter()
+  : m_interval(1)
+  , m_nSampledComponents(0)
+  , m_hasPrefixes(false)
+{
+}
+
+void
+TraceFilter::SetSamplingInterval(uint32_t interval)
+{
+  m_interval = interval;
+}
+
+void
+TraceFilter::AddPrefix(const Name& prefix, uint32_t interval)
+{
+  Ptr<Rule> rule = Create<Rule>();
+  rule->interval = interval;
+
+  auto item = m_prefixes.insert(prefix, rule);
+  if (!item.second) {
+    item.first->payload()->interval = interval;
+  }
+  m_hasPrefixes = true;
+}
+
+void
+TraceFilter::SetSampledComponents(size_t nComponents)
+{
+  m_nSampledComponents = nComponents;
+}
+
+bool
+TraceFilter::IsTraced(const Name& name) const
+{
+  uint32_t interval = m_interval;
+  if (m_hasPrefixes) {
+    PrefixTrie::iterator rule = m_prefixes.longest_prefix_match(name);
+    if (rule != m_prefixes.end()) {
+      interval = rule->payload()->interval;
+    }
+  }
+
+  if (interval == 1 || interval == 0)
+    return interval == 1;
+
+  size_t nComponents = name.size();
+  if (m_nSampledComponents != 0) {
+    nComponents = std::min(nComponents, m_nSampledComponents);
+  }
+  return GetHash(name, nComponents) % interval == 0;
+}
+
+uint64_t
+TraceFilter::GetHash(const Name& name, size_t nComponents)
+{
+  // FNV-1a over types and values of the components, then the finalizer of MurmurHash3, so that
+  // the low bits used by the modulo depend on all bytes
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash] (uint8_t byte) {
+    hash = (hash ^ byte) * 1099511628211ULL;
+  };
+
+  for (size_t i = 0; i < nComponents; i++) {
+    const name::Component& component = name.get(i);
+    add(static_cast<uint8_t>(component.type()));
+    for (size_t i = 0; i < component.value_size(); i++) {
+      add(component.value()[i]);
+    }
+    add(0xFF);
+  }
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+void
+TraceFilter::Install(const NodeContainer& nodes, Ptr<TraceFilter> filter)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 == nullptr) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " has no NDN stack");
+      continue;
+    }
+    l3->setTraceFilter(filter);
+  }
+}
+
+void
+TraceFilter::InstallAll(Ptr<TraceFilter> filter)
+{
+  Install(NodeContainer::GetGlobal(), filter);
+}
+
+void
+TraceFilter::InstallOnly(const NodeContainer& nodes, Ptr<TraceFilter> filter)
+{
+  Ptr<TraceFilter> none = Create<TraceFilter>();
+  none->SetSamplingInterval(0);
+  InstallAll(none);
+
+  Install(nodes, filter);
+}
+
+} // namespace ndn
+} // namespace ns3
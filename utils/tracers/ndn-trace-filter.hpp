@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_FILTER_H
+#define NDN_TRACE_FILTER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node-container.h"
+
+#include "../trie/trie-with-policy.hpp"
+#include "../trie/empty-policy.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Selects packets reported by the trace sources of L3Protocol
+ *
+ * The filter is evaluated by L3Protocol before a trace source is fired, so the packets that are
+ * filtered out are not seen by any tracer (L3RateTracer, custom tracers connected to the trace
+ * sources, and application delay traces of consumers on the node).  Nodes without a filter
+ * report all packets.
+ *
+ * A packet is sampled by its name: 1 in N names is reported, where N is the sampling interval
+ * of the longest prefix of the name added with AddPrefix, or the default sampling interval if
+ * there is no such prefix.  An interval of 0 filters out all the names.  As the choice depends
+ * only on the name, an Interest, its Data and Nacks are either all reported or all filtered out,
+ * on every node with the same filter settings.  Satisfied and timed out Interests are sampled by
+ * the name of their PIT entry.
+ *
+ * This holds as long as Data names are equal to Interest names.  When Data names can be longer
+ * (e.g., producers appending a postfix to answer Interests with CanBePrefix), use
+ * SetSampledComponents, so that only the components common to Interest and Data names decide.
+ *
+ * Rates reported by the tracers are those of the sampled packets; multiply them by N to
+ * estimate the total.
+ */
+class TraceFilter : public SimpleRefCount<TraceFilter> {
+public:
+  /**
+   * @brief Create filter reporting all packets
+   */
+  TraceFilter();
+
+  /**
+   * @brief Set sampling interval of the names that are not under any added prefix
+   *
+   * @param interval Report 1 of interval names (0 to filter out all)
+   */
+  void
+  SetSamplingInterval(uint32_t interval);
+
+  /**
+   * @brief Set sampling interval of the names under the prefix
+   *
+   * The interval of the longest matching prefix applies, e.g., "/" with 0 and "/video" with 10
+   * reports 1 of 10 names under "/video" and nothing else.
+   *
+   * @param prefix Prefix of the names
+   * @param interval Report 1 of interval names (0 to filter out all)
+   */
+  void
+  AddPrefix(const Name& prefix, uint32_t interval = 1);
+
+  /**
+   * @brief Sample names by their first @p nComponents components only
+   *
+   * E.g., with Interests for /prefix/<seq> answered by Data /prefix/<seq>/<producer>, 2 samples
+   * every Data together with its Interest.  Sampling intervals are still selected by the whole
+   * name.
+   *
+   * @param nComponents Number of leading components (0, the default, to use whole names)
+   */
+  void
+  SetSampledComponents(size_t nComponents);
+
+  /**
+   * @brief Check whether packets with the name are reported
+   */
+  bool
+  IsTraced(const Name& name) const;
+
+  /**
+   * @brief Install the filter on the nodes (nullptr to report all packets)
+   *
+   * Nodes without NDN stack are skipped.
+   */
+  static void
+  Install(const NodeContainer& nodes, Ptr<TraceFilter> filter);
+
+  /**
+   * @brief Install the filter on all simulation nodes (nullptr to report all packets)
+   */
+  static void
+  InstallAll(Ptr<TraceFilter> filter);
+
+  /**
+   * @brief Install the filter on the nodes and filter out all packets on all other nodes
+   */
+  static void
+  InstallOnly(const NodeContainer& nodes, Ptr<TraceFilter> filter = Create<TraceFilter>());
+
+private:
+  static uint64_t
+  GetHash(const Name& name, size_t nComponents);
+
+private:
+  /// @cond include_hidden
+  struct Rule : public SimpleRefCount<Rule> {
+    uint32_t interval;
+  };
+  /// @endcond
+
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<Rule>,
+                                   ndnSIM::empty_policy_traits> PrefixTrie;
+
+  uint32_t m_interval;
+  size_t m_nSampledComponents;
+  bool m_hasPrefixes;
+  mutable PrefixTrie m_prefixes; ///< @brief sampling intervals of the prefixes
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_FILTER_H
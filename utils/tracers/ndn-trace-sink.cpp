@@ -0,0 +1,470 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+#include "ndn-async-output-stream.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char MAGIC[] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t VERSION = 1;
+
+bool g_isAsyncWriting = true;
+size_t g_bufferSize = AsyncOutputStream::DEFAULT_BLOCK_SIZE;
+size_t g_nBuffers = AsyncOutputStream::DEFAULT_NUM_BLOCKS;
+
+/**
+ * @brief File stream with a buffer of the given size
+ */
+class BufferedFileStream : public std::ofstream {
+public:
+  explicit BufferedFileStream(size_t bufferSize)
+    : m_buffer(bufferSize)
+  {
+    rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+  }
+
+  ~BufferedFileStream()
+  {
+    close(); // before the buffer is freed
+  }
+
+private:
+  std::vector<char> m_buffer;
+};
+
+size_t
+getWidth(TraceSink::ColumnType type)
+{
+  return type == TraceSink::COLUMN_STRING ? sizeof(uint32_t) : sizeof(uint64_t);
+}
+
+void
+writeInteger(std::ostream& os, uint64_t value, size_t width)
+{
+  char bytes[sizeof(uint64_t)];
+  for (size_t i = 0; i < width; i++) {
+    bytes[i] = static_cast<char>(value >> (8 * i));
+  }
+  os.write(bytes, width);
+}
+
+uint64_t
+readInteger(const char* bytes, size_t width)
+{
+  uint64_t value = 0;
+  for (size_t i = width; i > 0; i--) {
+    value = (value << 8) | static_cast<uint8_t>(bytes[i - 1]);
+  }
+  return value;
+}
+
+uint64_t
+readInteger(std::istream& is, size_t width)
+{
+  char bytes[sizeof(uint64_t)];
+  if (!is.read(bytes, width)) {
+    BOOST_THROW_EXCEPTION(BinaryTraceReader::Error("Truncated trace"));
+  }
+  return readInteger(bytes, width);
+}
+
+std::string
+readString(std::istream& is, size_t length)
+{
+  std::string value(length, '\0');
+  if (length > 0 && !is.read(&value[0], length)) {
+    BOOST_THROW_EXCEPTION(BinaryTraceReader::Error("Truncated trace"));
+  }
+  return value;
+}
+
+} // namespace
+
+void
+TraceSink::SetAsyncWriting(bool isEnabled)
+{
+  g_isAsyncWriting = isEnabled;
+}
+
+void
+TraceSink::SetBufferSize(size_t size, size_t nBuffers)
+{
+  g_bufferSize = std::max<size_t>(size, 1);
+  g_nBuffers = std::max<size_t>(nBuffers, 2);
+}
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file, const Schema& schema)
+{
+  if (file == "-") {
+    return make_shared<TsvTraceSink>(shared_ptr<std::ostream>(&std::cout, std::bind([]{})),
+                                     schema);
+  }
+
+  bool isBinary = boost::algorithm::ends_with(file, ".bin");
+
+  // with the background writer, the file is written in whole buffers
+  shared_ptr<std::ofstream> ofs = g_isAsyncWriting ? make_shared<std::ofstream>()
+                                                   : make_shared<BufferedFileStream>(g_bufferSize);
+  ofs->open(file.c_str(), std::ios_base::out | std::ios_base::trunc
+                            | (isBinary ? std::ios_base::binary : std::ios_base::openmode()));
+  if (!ofs->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  shared_ptr<std::ostream> os = ofs;
+  if (g_isAsyncWriting) {
+    os = make_shared<AsyncOutputStream>(ofs, g_bufferSize, g_nBuffers);
+  }
+
+  if (isBinary) {
+    return make_shared<BinaryTraceSink>(os, schema);
+  }
+  return make_shared<TsvTraceSink>(os, schema);
+}
+
+TraceSink::TraceSink(const Schema& schema)
+  : m_schema(schema)
+{
+}
+
+TraceSink::~TraceSink()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+TsvTraceSink::TsvTraceSink(shared_ptr<std::ostream> os, const Schema& schema, bool printHeader)
+  : TraceSink(schema)
+  , m_os(os)
+  , m_isFirstField(true)
+{
+  if (printHeader) {
+    PrintHeader(*m_os, m_schema);
+    *m_os << "\n";
+  }
+}
+
+void
+TsvTraceSink::PrintHeader(std::ostream& os, const Schema& schema)
+{
+  for (size_t i = 0; i < schema.size(); i++) {
+    os << (i > 0 ? "\t" : "") << schema[i].name;
+  }
+}
+
+void
+TsvTraceSink::Separate()
+{
+  if (!m_isFirstField) {
+    *m_os << "\t";
+  }
+  m_isFirstField = false;
+}
+
+void
+TsvTraceSink::AddDouble(double value)
+{
+  Separate();
+  *m_os << value;
+}
+
+void
+TsvTraceSink::AddInteger(int64_t value)
+{
+  Separate();
+  *m_os << value;
+}
+
+void
+TsvTraceSink::AddString(const std::string& value)
+{
+  Separate();
+  *m_os << value;
+}
+
+void
+TsvTraceSink::EndRecord()
+{
+  *m_os << "\n";
+  m_isFirstField = true;
+}
+
+void
+TsvTraceSink::Flush()
+{
+  m_os->flush();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BinaryTraceSink::BinaryTraceSink(shared_ptr<std::ostream> os, const Schema& schema,
+                                 size_t blockSize)
+  : TraceSink(schema)
+  , m_os(os)
+  , m_blockSize(blockSize)
+  , m_nRecords(0)
+  , m_field(0)
+  , m_columns(schema.size())
+{
+  NS_ASSERT(m_blockSize > 0);
+
+  for (size_t i = 0; i < m_schema.size(); i++) {
+    m_columns[i].reserve(getWidth(m_schema[i].type) * std::min<size_t>(m_blockSize, 4096));
+  }
+
+  m_os->write(MAGIC, sizeof(MAGIC));
+  writeInteger(*m_os, VERSION, sizeof(uint32_t));
+  writeInteger(*m_os, m_schema.size(), sizeof(uint32_t));
+  for (const Column& column : m_schema) {
+    writeInteger(*m_os, column.type, sizeof(uint8_t));
+    writeInteger(*m_os, column.name.size(), sizeof(uint16_t));
+    m_os->write(column.name.data(), column.name.size());
+  }
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+  Flush();
+}
+
+void
+BinaryTraceSink::Append(uint64_t value, size_t width)
+{
+  NS_ASSERT(m_field < m_columns.size());
+  std::string& column = m_columns[m_field++];
+  for (size_t i = 0; i < width; i++) {
+    column.push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+void
+BinaryTraceSink::AddDouble(double value)
+{
+  NS_ASSERT(m_schema[m_field].type == COLUMN_DOUBLE);
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  Append(bits, sizeof(bits));
+}
+
+void
+BinaryTraceSink::AddInteger(int64_t value)
+{
+  NS_ASSERT(m_schema[m_field].type == COLUMN_INTEGER);
+  Append(static_cast<uint64_t>(value), sizeof(uint64_t));
+}
+
+void
+BinaryTraceSink::AddString(const std::string& value)
+{
+  NS_ASSERT(m_schema[m_field].type == COLUMN_STRING);
+  auto entry = m_dictionary.insert(std::make_pair(value, m_dictionary.size()));
+  if (entry.second) {
+    m_newStrings.push_back(value);
+  }
+  Append(entry.first->second, sizeof(uint32_t));
+}
+
+void
+BinaryTraceSink::EndRecord()
+{
+  NS_ASSERT(m_field == m_columns.size());
+  m_field = 0;
+  if (++m_nRecords == m_blockSize) {
+    // only hand the block to the stream: flushing an asynchronous stream waits for the writer
+    WriteBlock();
+  }
+}
+
+void
+BinaryTraceSink::Flush()
+{
+  WriteBlock();
+  m_os->flush();
+}
+
+void
+BinaryTraceSink::WriteBlock()
+{
+  NS_ASSERT(m_field == 0);
+  if (m_nRecords > 0) {
+    std::string raw;
+    for (std::string& column : m_columns) {
+      raw += column;
+      column.clear();
+    }
+
+    std::string compressed;
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor());
+      out.push(boost::iostreams::back_inserter(compressed));
+      out.write(raw.data(), raw.size());
+    }
+
+    writeInteger(*m_os, m_nRecords, sizeof(uint32_t));
+    writeInteger(*m_os, m_newStrings.size(), sizeof(uint32_t));
+    for (const std::string& value : m_newStrings) {
+      writeInteger(*m_os, value.size(), sizeof(uint32_t));
+      m_os->write(value.data(), value.size());
+    }
+    writeInteger(*m_os, raw.size(), sizeof(uint32_t));
+    writeInteger(*m_os, compressed.size(), sizeof(uint32_t));
+    m_os->write(compressed.data(), compressed.size());
+
+    m_nRecords = 0;
+    m_newStrings.clear();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+{
+  char magic[sizeof(MAGIC)];
+  if (!m_is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    BOOST_THROW_EXCEPTION(Error("Not a binary trace"));
+  }
+  if (readInteger(m_is, sizeof(uint32_t)) != VERSION) {
+    BOOST_THROW_EXCEPTION(Error("Unsupported binary trace version"));
+  }
+
+  size_t nColumns = readInteger(m_is, sizeof(uint32_t));
+  for (size_t i = 0; i < nColumns; i++) {
+    TraceSink::Column column;
+    uint64_t type = readInteger(m_is, sizeof(uint8_t));
+    if (type > TraceSink::COLUMN_STRING) {
+      BOOST_THROW_EXCEPTION(Error("Unknown column type"));
+    }
+    column.type = static_cast<TraceSink::ColumnType>(type);
+    column.name = readString(m_is, readInteger(m_is, sizeof(uint16_t)));
+    m_schema.push_back(column);
+  }
+}
+
+uint64_t
+BinaryTraceReader::ReadAll(TraceSink& sink)
+{
+  uint64_t nRecords = 0;
+  while (ReadBlock(sink, nRecords)) {
+  }
+  return nRecords;
+}
+
+bool
+BinaryTraceReader::ReadBlock(TraceSink& sink, uint64_t& nRecords)
+{
+  if (m_is.peek() == std::char_traits<char>::eof()) {
+    return false;
+  }
+
+  size_t nBlockRecords = readInteger(m_is, sizeof(uint32_t));
+  size_t nNewStrings = readInteger(m_is, sizeof(uint32_t));
+  for (size_t i = 0; i < nNewStrings; i++) {
+    m_dictionary.push_back(readString(m_is, readInteger(m_is, sizeof(uint32_t))));
+  }
+
+  size_t rawSize = readInteger(m_is, sizeof(uint32_t));
+  std::string compressed = readString(m_is, readInteger(m_is, sizeof(uint32_t)));
+
+  std::string raw;
+  {
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::iostreams::array_source(compressed.data(), compressed.size()));
+    try {
+      boost::iostreams::copy(in, boost::iostreams::back_inserter(raw));
+    }
+    catch (const boost::iostreams::zlib_error&) {
+      BOOST_THROW_EXCEPTION(Error("Corrupted trace block"));
+    }
+  }
+
+  size_t recordSize = 0;
+  for (const TraceSink::Column& column : m_schema) {
+    recordSize += getWidth(column.type);
+  }
+  if (raw.size() != rawSize || raw.size() != recordSize * nBlockRecords) {
+    BOOST_THROW_EXCEPTION(Error("Corrupted trace block"));
+  }
+
+  // start of every column within the block
+  std::vector<const char*> columns;
+  const char* column = raw.data();
+  for (const TraceSink::Column& schemaColumn : m_schema) {
+    columns.push_back(column);
+    column += getWidth(schemaColumn.type) * nBlockRecords;
+  }
+
+  for (size_t record = 0; record < nBlockRecords; record++) {
+    for (size_t i = 0; i < m_schema.size(); i++) {
+      size_t width = getWidth(m_schema[i].type);
+      uint64_t value = readInteger(columns[i] + record * width, width);
+      switch (m_schema[i].type) {
+      case TraceSink::COLUMN_DOUBLE: {
+        double doubleValue;
+        std::memcpy(&doubleValue, &value, sizeof(doubleValue));
+        sink.AddDouble(doubleValue);
+        break;
+      }
+      case TraceSink::COLUMN_INTEGER:
+        sink.AddInteger(static_cast<int64_t>(value));
+        break;
+      case TraceSink::COLUMN_STRING:
+        if (value >= m_dictionary.size()) {
+          BOOST_THROW_EXCEPTION(Error("Unknown string in trace"));
+        }
+        sink.AddString(m_dictionary[value]);
+        break;
+      }
+    }
+    sink.EndRecord();
+  }
+
+  nRecords += nBlockRecords;
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Destination of tracer records
+ *
+ * Tracers declare their columns once (the schema) and then add the fields of every record in
+ * schema order, followed by EndRecord.  The sink decides how the records are stored:
+ *
+ * - TsvTraceSink writes tab-separated text with a header line (the traditional format);
+ * - BinaryTraceSink writes a compressed binary columnar format, which can be converted to text
+ *   with the ndn-trace-convert program.
+ */
+class TraceSink {
+public:
+  enum ColumnType : uint8_t {
+    COLUMN_DOUBLE = 0,  ///< @brief 64-bit floating point
+    COLUMN_INTEGER = 1, ///< @brief 64-bit signed integer
+    COLUMN_STRING = 2   ///< @brief string, e.g., node name or face description
+  };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  typedef std::vector<Column> Schema;
+
+  /**
+   * @brief Open sink writing into the file
+   *
+   * If file is "-", text is written to std::cout.  Files with the ".bin" extension get the
+   * binary columnar format, all other files get text.
+   *
+   * Unless disabled with SetAsyncWriting, files are written by a background thread (see
+   * AsyncOutputStream), so records are only copied into memory during the simulation and
+   * written out when Flush is called or the sink is destroyed.
+   *
+   * @returns nullptr if the file cannot be opened for writing
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, const Schema& schema);
+
+  /**
+   * @brief Enable or disable writing of the files opened afterwards in a background thread
+   *
+   * Enabled by default.
+   */
+  static void
+  SetAsyncWriting(bool isEnabled);
+
+  /**
+   * @brief Set size of the output buffers of the files opened afterwards
+   *
+   * With the background writer, each file gets nBuffers buffers (at least 2) of the given size.
+   * Otherwise, each file gets one buffer of the given size.  The default is two 1 MiB buffers.
+   */
+  static void
+  SetBufferSize(size_t size, size_t nBuffers = 2);
+
+  explicit TraceSink(const Schema& schema);
+
+  virtual ~TraceSink();
+
+  const Schema&
+  GetSchema() const
+  {
+    return m_schema;
+  }
+
+  virtual void
+  AddDouble(double value) = 0;
+
+  virtual void
+  AddInteger(int64_t value) = 0;
+
+  virtual void
+  AddString(const std::string& value) = 0;
+
+  /**
+   * @brief Finish the record, all columns of which must have been added
+   */
+  virtual void
+  EndRecord() = 0;
+
+  /**
+   * @brief Write out buffered records
+   */
+  virtual void
+  Flush() = 0;
+
+protected:
+  Schema m_schema;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tab-separated text, one line per record, preceded by the column names
+ */
+class TsvTraceSink : public TraceSink {
+public:
+  TsvTraceSink(shared_ptr<std::ostream> os, const Schema& schema, bool printHeader = true);
+
+  /**
+   * @brief Print tab-separated column names (without the line end)
+   */
+  static void
+  PrintHeader(std::ostream& os, const Schema& schema);
+
+  virtual void
+  AddDouble(double value);
+
+  virtual void
+  AddInteger(int64_t value);
+
+  virtual void
+  AddString(const std::string& value);
+
+  virtual void
+  EndRecord();
+
+  virtual void
+  Flush();
+
+private:
+  void
+  Separate();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  bool m_isFirstField;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary columnar format
+ *
+ * Records are collected into blocks of up to BlockSize records.  Within a block, every column is
+ * stored contiguously as fixed-width little-endian values: 8 bytes for doubles and integers and
+ * a 4-byte index into the string dictionary for strings.  The columns of a block are compressed
+ * together with zlib.
+ *
+ * The dictionary is built incrementally: every block first lists the strings that are used for
+ * the first time in it, so each node or face description is stored once per file.
+ *
+ * Layout (all integers little-endian):
+ *
+ *     file   := "NDNTRACE" version:u32 nColumns:u32 (type:u8 nameLength:u16 name)*  block*
+ *     block  := nRecords:u32 nNewStrings:u32 (length:u32 string)*
+ *               rawSize:u32 compressedSize:u32 zlib(column*)
+ */
+class BinaryTraceSink : public TraceSink {
+public:
+  static const size_t DEFAULT_BLOCK_SIZE = 65536;
+
+  BinaryTraceSink(shared_ptr<std::ostream> os, const Schema& schema,
+                  size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+  /**
+   * @brief Write out the last (incomplete) block
+   */
+  virtual ~BinaryTraceSink();
+
+  virtual void
+  AddDouble(double value);
+
+  virtual void
+  AddInteger(int64_t value);
+
+  virtual void
+  AddString(const std::string& value);
+
+  virtual void
+  EndRecord();
+
+  virtual void
+  Flush();
+
+private:
+  void
+  Append(uint64_t value, size_t width);
+
+  /**
+   * @brief Encode records of the current block into the stream, without flushing the stream
+   */
+  void
+  WriteBlock();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  size_t m_blockSize;
+  size_t m_nRecords;
+  size_t m_field;
+  std::vector<std::string> m_columns; ///< @brief fixed-width values of the current block
+
+  std::unordered_map<std::string, uint32_t> m_dictionary;
+  std::vector<std::string> m_newStrings; ///< @brief strings first used in the current block
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reads files written by BinaryTraceSink
+ */
+class BinaryTraceReader {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Read the file header
+   * @throws Error if the stream is not in the binary trace format
+   */
+  explicit BinaryTraceReader(std::istream& is);
+
+  const TraceSink::Schema&
+  GetSchema() const
+  {
+    return m_schema;
+  }
+
+  /**
+   * @brief Add all remaining records to the sink
+   * @returns number of records
+   * @throws Error if the stream is truncated or corrupted
+   */
+  uint64_t
+  ReadAll(TraceSink& sink);
+
+private:
+  bool
+  ReadBlock(TraceSink& sink, uint64_t& nRecords);
+
+private:
+  std::istream& m_is;
+  TraceSink::Schema m_schema;
+  std::vector<std::string> m_dictionary;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H
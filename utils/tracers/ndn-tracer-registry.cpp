@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tracer-registry.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TracerRegistry");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::pair<std::type_index, Ptr<TracerGroup>>> g_groups; // in installation order
+static std::map<std::string, std::weak_ptr<TraceSink>> g_files;
+
+static bool
+isSameSchema(const TraceSink::Schema& a, const TraceSink::Schema& b)
+{
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(),
+                    [] (const TraceSink::Column& x, const TraceSink::Column& y) {
+                      return x.name == y.name && x.type == y.type;
+                    });
+}
+
+static void
+forgetClosedFiles()
+{
+  for (auto file = g_files.begin(); file != g_files.end();) {
+    if (file->second.expired()) {
+      file = g_files.erase(file);
+    }
+    else {
+      ++file;
+    }
+  }
+}
+
+TracerGroup::TracerGroup(shared_ptr<TraceSink> sink)
+  : m_sink(sink)
+{
+}
+
+TracerGroup::~TracerGroup()
+{
+}
+
+void
+TracerGroup::Flush()
+{
+  m_sink->Flush();
+}
+
+shared_ptr<TraceSink>
+TracerRegistry::Open(const std::string& file, const TraceSink::Schema& schema)
+{
+  auto i = g_files.find(file);
+  if (i != g_files.end()) {
+    shared_ptr<TraceSink> sink = i->second.lock();
+    if (sink != nullptr) {
+      if (!isSameSchema(sink->GetSchema(), schema)) {
+        NS_FATAL_ERROR("File " << file << " is already used by a trace with different columns");
+      }
+      NS_LOG_DEBUG("Sharing " << file);
+      return sink;
+    }
+  }
+
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, schema);
+  if (sink != nullptr) {
+    g_files[file] = sink;
+  }
+  return sink;
+}
+
+void
+TracerRegistry::Add(std::type_index kind, Ptr<TracerGroup> group)
+{
+  if (g_groups.empty()) {
+    Simulator::ScheduleDestroy(&TracerRegistry::DestroyAll);
+  }
+  g_groups.push_back(std::make_pair(kind, group));
+}
+
+std::vector<Ptr<TracerGroup>>
+TracerRegistry::Find(std::type_index kind, const shared_ptr<TraceSink>& sink)
+{
+  std::vector<Ptr<TracerGroup>> groups;
+  for (const auto& group : g_groups) {
+    if (group.first == kind && group.second->GetSink() == sink) {
+      groups.push_back(group.second);
+    }
+  }
+  return groups;
+}
+
+void
+TracerRegistry::Destroy(std::type_index kind)
+{
+  for (const auto& group : g_groups) {
+    if (group.first == kind) {
+      group.second->Flush();
+    }
+  }
+  g_groups.remove_if([kind] (const std::pair<std::type_index, Ptr<TracerGroup>>& group) {
+      return group.first == kind;
+    });
+  forgetClosedFiles();
+}
+
+void
+TracerRegistry::DestroyAll()
+{
+  for (const auto& group : g_groups) {
+    group.second->Flush();
+  }
+  g_groups.clear();
+  forgetClosedFiles();
+}
+
+} // namespace ndn
+} // namespace ns3
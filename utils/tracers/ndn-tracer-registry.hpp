@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACER_REGISTRY_H
+#define NDN_TRACER_REGISTRY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node-container.h"
+
+#include <list>
+#include <typeindex>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracers installed together into one file (e.g., by one InstallAll call)
+ */
+class TracerGroup : public SimpleRefCount<TracerGroup> {
+public:
+  explicit TracerGroup(shared_ptr<TraceSink> sink);
+
+  virtual ~TracerGroup();
+
+  const shared_ptr<TraceSink>&
+  GetSink() const
+  {
+    return m_sink;
+  }
+
+  /**
+   * @brief Write out pending records (by default, flush the sink)
+   */
+  virtual void
+  Flush();
+
+protected:
+  shared_ptr<TraceSink> m_sink;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Group of tracers that write their records themselves
+ */
+template<class Tracer>
+class TracerList : public TracerGroup {
+public:
+  explicit TracerList(shared_ptr<TraceSink> sink)
+    : TracerGroup(sink)
+  {
+  }
+
+  void
+  Add(Ptr<Tracer> tracer)
+  {
+    m_tracers.push_back(tracer);
+  }
+
+private:
+  std::list<Ptr<Tracer>> m_tracers;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Keeps tracer groups installed into files alive until they are destroyed
+ *
+ * Trace files are shared: all groups writing into the same file (with the same columns) get the
+ * same sink, so the file is opened once and its records go through one buffer (see
+ * TraceSink::SetBufferSize).
+ *
+ * Groups are destroyed by the Destroy method of their tracer kind (e.g., L3RateTracer::Destroy),
+ * by DestroyAll, or when the simulator is destroyed, whichever comes first.
+ */
+class TracerRegistry {
+public:
+  /**
+   * @brief Get sink writing into the file, opening the file if it is not open yet
+   *
+   * A file opened for a trace with different columns is a fatal error.
+   *
+   * @returns nullptr if the file cannot be opened for writing
+   * @see TraceSink::Open
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, const TraceSink::Schema& schema);
+
+  /**
+   * @brief Keep the group of tracers of the given kind
+   */
+  template<class Tracer>
+  static void
+  Add(Ptr<TracerGroup> group)
+  {
+    Add(std::type_index(typeid(Tracer)), group);
+  }
+
+  /**
+   * @brief Get groups of tracers of the given kind writing into the sink, in installation order
+   */
+  template<class Tracer>
+  static std::vector<Ptr<TracerGroup>>
+  Find(const shared_ptr<TraceSink>& sink)
+  {
+    return Find(std::type_index(typeid(Tracer)), sink);
+  }
+
+  /**
+   * @brief Install tracers on the nodes, writing into the file
+   *
+   * Tracers are created with Tracer::Install(node, sink, args...).
+   */
+  template<class Tracer, class... Args>
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, const Args&... args)
+  {
+    shared_ptr<TraceSink> sink = Open(file, Tracer::GetSchema());
+    if (sink == nullptr) {
+      return;
+    }
+
+    Ptr<TracerList<Tracer>> group = Create<TracerList<Tracer>>(sink);
+    for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+      group->Add(Tracer::Install(*node, sink, args...));
+    }
+    Add<Tracer>(group);
+  }
+
+  /**
+   * @brief Flush (in the order of installation) and remove groups of the given kind
+   */
+  template<class Tracer>
+  static void
+  Destroy()
+  {
+    Destroy(std::type_index(typeid(Tracer)));
+  }
+
+  /**
+   * @brief Flush (in the order of installation) and remove all groups
+   *
+   * Returns after all buffered records are written to the files.
+   */
+  static void
+  DestroyAll();
+
+private:
+  static void
+  Add(std::type_index kind, Ptr<TracerGroup> group);
+
+  static std::vector<Ptr<TracerGroup>>
+  Find(std::type_index kind, const shared_ptr<TraceSink>& sink);
+
+  static void
+  Destroy(std::type_index kind);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACER_REGISTRY_H
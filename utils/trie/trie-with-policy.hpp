@@ -253,6 +253,52 @@ public:
     }
   }
 
+  /**
+   * @brief Find a node that exactly matches the prefix, whether it has payload or not
+   */
+  inline iterator
+  find_prefix_node(const FullKey& prefix)
+  {
+    iterator foundItem, lastItem;
+    bool reachLast;
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(prefix);
+
+    if (!reachLast)
+      return end();
+
+    return lastItem;
+  }
+
+  /**
+   * @brief Get number of payloads with keys starting with the prefix (O(prefix length))
+   */
+  inline size_t
+  count_under_prefix(const FullKey& prefix)
+  {
+    iterator node = find_prefix_node(prefix);
+    if (node == end())
+      return 0;
+
+    return node->payload_count();
+  }
+
+  /**
+   * @brief Call function for every payload with the key starting with the prefix
+   *
+   * Only the sub-trie of the prefix is walked and the policy is not updated (i.e., visited
+   * entries are not considered as looked up).
+   */
+  template<class Function>
+  inline void
+  for_each_under_prefix(const FullKey& prefix, Function func)
+  {
+    iterator node = find_prefix_node(prefix);
+    if (node == end())
+      return;
+
+    node->for_each_payload(func);
+  }
+
   iterator
   end() const
   {
@@ -152,6 +152,7 @@ public:
                                              // container
     , children_(bucket_traits(buckets_.get(), bucketSize_))
     , payload_(PayloadTraits::empty_payload)
+    , payloadCount_(0)
     , parent_(nullptr)
   {
   }
@@ -165,6 +166,11 @@ public:
   void
   clear()
   {
+    size_t childrenPayloadCount =
+      payloadCount_ - (payload_ != PayloadTraits::empty_payload ? 1 : 0);
+    if (childrenPayloadCount > 0)
+      update_payload_count(-static_cast<std::ptrdiff_t>(childrenPayloadCount));
+
     children_.clear_and_dispose(trie_delete_disposer());
   }
 
@@ -221,7 +227,7 @@ public:
     }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload) {
-      trieNode->payload_ = payload;
+      trieNode->set_payload(payload);
       return std::make_pair(trieNode, true);
     }
     else
@@ -234,7 +240,7 @@ public:
   inline iterator
   erase()
   {
-    payload_ = PayloadTraits::empty_payload;
+    set_payload(PayloadTraits::empty_payload);
     return prune();
   }
 
@@ -444,7 +450,44 @@ public:
   void
   set_payload(typename PayloadTraits::insert_type payload)
   {
+    bool hadPayload = (payload_ != PayloadTraits::empty_payload);
     payload_ = payload;
+    bool hasPayload = (payload_ != PayloadTraits::empty_payload);
+
+    if (hadPayload != hasPayload)
+      update_payload_count(hasPayload ? 1 : -1);
+  }
+
+  /**
+   * @brief Get number of payloads in the sub-trie (including payload of this node)
+   *
+   * The counter is maintained incrementally, so the call is O(1)
+   */
+  size_t
+  payload_count() const
+  {
+    return payloadCount_;
+  }
+
+  /**
+   * @brief Call function for every payload of the sub-trie (order is not defined)
+   *
+   * Only branches that contain payloads are visited.  The function must not modify the trie.
+   */
+  template<class Function>
+  void
+  for_each_payload(Function& func)
+  {
+    if (payloadCount_ == 0)
+      return;
+
+    if (payload_ != PayloadTraits::empty_payload)
+      func(payload_);
+
+    for (typename unordered_set::iterator subnode = children_.begin(); subnode != children_.end();
+         subnode++) {
+      subnode->for_each_payload(func);
+    }
   }
 
   Key
@@ -477,6 +520,17 @@ private:
 
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
+  /**
+   * @brief Adjust payload counters of this node and all its parents
+   */
+  void
+  update_payload_count(std::ptrdiff_t delta)
+  {
+    for (trie* node = this; node != 0; node = node->parent_) {
+      node->payloadCount_ += delta;
+    }
+  }
+
 public:
   PolicyHook policy_hook_;
 
@@ -513,6 +567,7 @@ private:
   unordered_set children_;
 
   typename PayloadTraits::storage_type payload_;
+  size_t payloadCount_; ///< number of payloads in the sub-trie, including this node
   trie* parent_; // to make cleaning effective
 };
 